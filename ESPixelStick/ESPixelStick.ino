@@ -460,7 +460,8 @@ void loop()
     // Process input data
     InputMgr.Process ();
 
-    // Render output
+    // Render output. On the ESP32 the frames are sent by the output render task
+    // and this only applies config changes.
     OutputMgr.Render();
 
     WebMgr.Process ();
@@ -55,6 +55,9 @@ const CN_PROGMEM char CN_current_sequence         [] = "current_sequence";
 const CN_PROGMEM char CN_data_pin                 [] = "data_pin";
 const CN_PROGMEM char CN_device                   [] = "device";
 const CN_PROGMEM char CN_dhcp                     [] = "dhcp";
+const CN_PROGMEM char CN_dmxkeepalive             [] = "dmxkeepalive";
+const CN_PROGMEM char CN_dmxrate                  [] = "dmxrate";
+const CN_PROGMEM char CN_dmxvarlen                [] = "dmxvarlen";
 const CN_PROGMEM char CN_Dotfseq                  [] = ".fseq";
 const CN_PROGMEM char CN_Dotpl                    [] = ".pl";
 const CN_PROGMEM char CN_duration                 [] = "duration";
@@ -87,6 +90,8 @@ const CN_PROGMEM char CN_fseqfilename             [] = "fseqfilename";
 const CN_PROGMEM char CN_g                        [] = "g";
 const CN_PROGMEM char CN_gamma                    [] = "gamma";
 const CN_PROGMEM char CN_gateway                  [] = "gateway";
+const CN_PROGMEM char CN_gecechange               [] = "gecechange";
+const CN_PROGMEM char CN_gecerefresh              [] = "gecerefresh";
 const CN_PROGMEM char CN_get                      [] = "get";
 const CN_PROGMEM char CN_gen_ser_hdr              [] = "gen_ser_hdr";
 const CN_PROGMEM char CN_gen_ser_ftr              [] = "gen_ser_ftr";
@@ -97,9 +102,13 @@ const CN_PROGMEM char CN_hadisco                  [] = "hadisco";
 const CN_PROGMEM char CN_haprefix                 [] = "haprefix";
 const CN_PROGMEM char CN_HostName                 [] = "HostName";
 const CN_PROGMEM char CN_hostname                 [] = "hostname";
+const CN_PROGMEM char CN_hfr                      [] = "hfr";
 const CN_PROGMEM char CN_hv                       [] = "hv";
+const CN_PROGMEM char CN_i2caddrs                [] = "i2caddrs";
+const CN_PROGMEM char CN_i2ckhz                  [] = "i2ckhz";
 const CN_PROGMEM char CN_id                       [] = "id";
 const CN_PROGMEM char CN_Idle                     [] = "Idle";
+const CN_PROGMEM char CN_in                       [] = "in";
 const CN_PROGMEM char CN_init                     [] = "init";
 const CN_PROGMEM char CN_interframetime           [] = "interframetime";
 const CN_PROGMEM char CN_inv                      [] = "inv";
@@ -112,6 +121,8 @@ const CN_PROGMEM char CN_mac                      [] = "mac";
 const CN_PROGMEM char CN_mdc_pin                  [] = "mdc_pin";
 const CN_PROGMEM char CN_mdio_pin                 [] = "mdio_pin";
 const CN_PROGMEM char CN_Max                      [] = "Max";
+const CN_PROGMEM char CN_maxfps                   [] = "maxfps";
+const CN_PROGMEM char CN_merge                    [] = "merge";
 const CN_PROGMEM char CN_Min                      [] = "Min";
 const CN_PROGMEM char CN_minussigns               [] = "-----";
 const CN_PROGMEM char CN_mirror                   [] = "mirror";
@@ -126,11 +137,13 @@ const CN_PROGMEM char CN_netmask                  [] = "netmask";
 const CN_PROGMEM char CN_network                  [] = "network";
 const CN_PROGMEM char CN_num_chan                 [] = "num_chan";
 const CN_PROGMEM char CN_num_packets              [] = "num_packets";
+const CN_PROGMEM char CN_out                      [] = "out";
 const CN_PROGMEM char CN_output                   [] = "output";
 const CN_PROGMEM char CN_output_config            [] = "output_config";
 const CN_PROGMEM char CN_packet_errors            [] = "packet_errors";
 const CN_PROGMEM char CN_passphrase               [] = "passphrase";
 const CN_PROGMEM char CN_password                 [] = "password";
+const CN_PROGMEM char CN_patch                    [] = "patch";
 const CN_PROGMEM char CN_Paused                   [] = "Paused";
 const CN_PROGMEM char CN_pixel_count              [] = "pixel_count";
 const CN_PROGMEM char CN_Platform                 [] = "Platform";
@@ -143,11 +156,15 @@ const CN_PROGMEM char CN_port                     [] = "port";
 const CN_PROGMEM char CN_power_pin                [] = "power_pin";
 const CN_PROGMEM char CN_prependnullcount         [] = "prependnullcount";
 const CN_PROGMEM char CN_pwm                      [] = "pwm";
+const CN_PROGMEM char CN_pwmfade                  [] = "pwmfade";
 const CN_PROGMEM char CN_r                        [] = "r";
 const CN_PROGMEM char CN_remote                   [] = "remote";
 const CN_PROGMEM char CN_rev                      [] = "rev";
 const CN_PROGMEM char CN_reverse                  [] = "reverse";
 const CN_PROGMEM char CN_RMT                      [] = "RMT";
+const CN_PROGMEM char CN_rmtmaxblocks             [] = "rmtmaxblocks";
+const CN_PROGMEM char CN_rmtpreencode             [] = "rmtpreencode";
+const CN_PROGMEM char CN_rmtstartmode             [] = "rmtstartmode";
 const CN_PROGMEM char CN_rssi                     [] = "rssi";
 const CN_PROGMEM char CN_sca                      [] = "sca";
 const CN_PROGMEM char CN_seconds_elapsed          [] = "seconds_elapsed";
@@ -157,6 +174,8 @@ const CN_PROGMEM char CN_sequence_filename        [] = "sequence_filename";
 const CN_PROGMEM char CN_slashset                 [] = "/set";
 const CN_PROGMEM char CN_slashstatus              [] = "/status";
 const CN_PROGMEM char CN_speed                    [] = "speed";
+const CN_PROGMEM char CN_spiframe                 [] = "spiframe";
+const CN_PROGMEM char CN_spimhz                   [] = "spimhz";
 const CN_PROGMEM char CN_ssid                     [] = "ssid";
 const CN_PROGMEM char CN_sta_timeout              [] = "sta_timeout";
 const CN_PROGMEM char CN_stars                    [] = "***";
@@ -165,6 +184,7 @@ const CN_PROGMEM char CN_status                   [] = "status";
 const CN_PROGMEM char CN_status_name              [] = "status_name";
 const CN_PROGMEM char CN_subnet                   [] = "subnet";
 const CN_PROGMEM char CN_SyncOffset               [] = "SyncOffset";
+const CN_PROGMEM char CN_synctimeout             [] = "synctimeout";
 const CN_PROGMEM char CN_system                   [] = "system";
 const CN_PROGMEM char CN_textSLASHplain           [] = "text/plain";
 const CN_PROGMEM char CN_time                     [] = "time";
@@ -176,6 +196,7 @@ const CN_PROGMEM char CN_topicset                 [] = "topicset";
 const CN_PROGMEM char CN_trig                     [] = "trig";
 const CN_PROGMEM char CN_true                     [] = "true";
 const CN_PROGMEM char CN_type                     [] = "type";
+const CN_PROGMEM char CN_uartdma                  [] = "uartdma";
 const CN_PROGMEM char CN_ui                       [] = "ui";
 const CN_PROGMEM char CN_unichanlim               [] = "unichanlim";
 const CN_PROGMEM char CN_unifirst                 [] = "unifirst";
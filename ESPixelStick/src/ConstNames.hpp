@@ -64,6 +64,9 @@ extern const CN_PROGMEM char CN_current_sequence[];
 extern const CN_PROGMEM char CN_data_pin[];
 extern const CN_PROGMEM char CN_device [];
 extern const CN_PROGMEM char CN_dhcp[];
+extern const CN_PROGMEM char CN_dmxkeepalive[];
+extern const CN_PROGMEM char CN_dmxrate[];
+extern const CN_PROGMEM char CN_dmxvarlen[];
 extern const CN_PROGMEM char CN_Dotfseq[];
 extern const CN_PROGMEM char CN_Dotpl[];
 extern const CN_PROGMEM char CN_duration[];
@@ -96,6 +99,8 @@ extern const CN_PROGMEM char CN_fseqfilename[];
 extern const CN_PROGMEM char CN_gateway[];
 extern const CN_PROGMEM char CN_g[];
 extern const CN_PROGMEM char CN_gamma[];
+extern const CN_PROGMEM char CN_gecechange[];
+extern const CN_PROGMEM char CN_gecerefresh[];
 extern const CN_PROGMEM char CN_get[];
 extern const CN_PROGMEM char CN_gen_ser_hdr[];
 extern const CN_PROGMEM char CN_gen_ser_ftr[];
@@ -106,9 +111,13 @@ extern const CN_PROGMEM char CN_haprefix[];
 extern const CN_PROGMEM char CN_Heap_colon [];
 extern const CN_PROGMEM char CN_HostName [];
 extern const CN_PROGMEM char CN_hostname [];
+extern const CN_PROGMEM char CN_hfr[];
 extern const CN_PROGMEM char CN_hv[];
+extern const CN_PROGMEM char CN_i2caddrs[];
+extern const CN_PROGMEM char CN_i2ckhz[];
 extern const CN_PROGMEM char CN_id[];
 extern const CN_PROGMEM char CN_Idle[];
+extern const CN_PROGMEM char CN_in[];
 extern const CN_PROGMEM char CN_init[];
 extern const CN_PROGMEM char CN_interframetime[];
 extern const CN_PROGMEM char CN_inv[];
@@ -121,6 +130,8 @@ extern const CN_PROGMEM char CN_mac[];
 extern const CN_PROGMEM char CN_mdc_pin[];
 extern const CN_PROGMEM char CN_mdio_pin[];
 extern const CN_PROGMEM char CN_Max[];
+extern const CN_PROGMEM char CN_maxfps[];
+extern const CN_PROGMEM char CN_merge[];
 extern const CN_PROGMEM char CN_Min[];
 extern const CN_PROGMEM char CN_minussigns[];
 extern const CN_PROGMEM char CN_mirror [];
@@ -135,11 +146,13 @@ extern const CN_PROGMEM char CN_netmask [];
 extern const CN_PROGMEM char CN_network [];
 extern const CN_PROGMEM char CN_num_chan[];
 extern const CN_PROGMEM char CN_num_packets[];
+extern const CN_PROGMEM char CN_out[];
 extern const CN_PROGMEM char CN_output[];
 extern const CN_PROGMEM char CN_output_config[];
 extern const CN_PROGMEM char CN_packet_errors[];
 extern const CN_PROGMEM char CN_passphrase[];
 extern const CN_PROGMEM char CN_password[];
+extern const CN_PROGMEM char CN_patch[];
 extern const CN_PROGMEM char CN_Paused[];
 extern const CN_PROGMEM char CN_pixel_count[];
 extern const CN_PROGMEM char CN_polarity[];
@@ -152,11 +165,15 @@ extern const CN_PROGMEM char CN_plussigns [];
 extern const CN_PROGMEM char CN_power_pin[];
 extern const CN_PROGMEM char CN_prependnullcount [];
 extern const CN_PROGMEM char CN_pwm [];
+extern const CN_PROGMEM char CN_pwmfade[];
 extern const CN_PROGMEM char CN_remote[];
 extern const CN_PROGMEM char CN_r[];
 extern const CN_PROGMEM char CN_rev[];
 extern const CN_PROGMEM char CN_reverse[];
 extern const CN_PROGMEM char CN_RMT[];
+extern const CN_PROGMEM char CN_rmtmaxblocks[];
+extern const CN_PROGMEM char CN_rmtpreencode[];
+extern const CN_PROGMEM char CN_rmtstartmode[];
 extern const CN_PROGMEM char CN_rssi[];
 extern const CN_PROGMEM char CN_sca[];
 extern const CN_PROGMEM char CN_seconds_elapsed[];
@@ -166,6 +183,8 @@ extern const CN_PROGMEM char CN_sequence_filename[];
 extern const CN_PROGMEM char CN_slashset[];
 extern const CN_PROGMEM char CN_slashstatus[];
 extern const CN_PROGMEM char CN_speed[];
+extern const CN_PROGMEM char CN_spiframe[];
+extern const CN_PROGMEM char CN_spimhz[];
 extern const CN_PROGMEM char CN_ssid [];
 extern const CN_PROGMEM char CN_sta_timeout [];
 extern const CN_PROGMEM char CN_stars[];
@@ -174,6 +193,7 @@ extern const CN_PROGMEM char CN_status [];
 extern const CN_PROGMEM char CN_status_name[];
 extern const CN_PROGMEM char CN_subnet[];
 extern const CN_PROGMEM char CN_SyncOffset[];
+extern const CN_PROGMEM char CN_synctimeout[];
 extern const CN_PROGMEM char CN_system[];
 extern const CN_PROGMEM char CN_textSLASHplain[];
 extern const CN_PROGMEM char CN_time[];
@@ -185,6 +205,7 @@ extern const CN_PROGMEM char CN_topicset[];
 extern const CN_PROGMEM char CN_trig[];
 extern const CN_PROGMEM char CN_true[];
 extern const CN_PROGMEM char CN_type[];
+extern const CN_PROGMEM char CN_uartdma[];
 extern const CN_PROGMEM char CN_ui[];
 extern const CN_PROGMEM char CN_unichanlim[];
 extern const CN_PROGMEM char CN_unifirst[];
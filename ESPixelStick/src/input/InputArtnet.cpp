@@ -38,6 +38,9 @@ c_InputArtnet::~c_InputArtnet()
 {
     // DEBUG_START;
 
+    // do not leave the outputs waiting for a sync that will never come
+    ResetSync ();
+
     // DEBUG_END;
 
 } // ~c_InputArtnet
@@ -96,6 +99,13 @@ void c_InputArtnet::GetStatus (JsonObject & jsonStatus)
     ArtnetStatus[CN_packet_errors] = packet_errors;
     ArtnetStatus[CN_last_clientIP] = LastRemoteIP.toString ();
 
+    ArtnetStatus[F ("SyncMode")]     = SyncMode;
+    ArtnetStatus[F ("SyncNoMem")]    = SyncUnavailable;
+    ArtnetStatus[F ("SyncFrames")]   = SyncFrameCounter;
+    ArtnetStatus[F ("SyncLate")]     = LateSyncCounter;
+    ArtnetStatus[F ("SyncTimeouts")] = SyncTimeoutCounter;
+    ArtnetStatus[F ("SyncIgnored")]  = SyncIgnoredCounter;
+
     JsonArray ArtnetUniverseStatus = ArtnetStatus.createNestedArray (CN_channels);
 
     for (auto & CurrentUniverse : UniverseArray)
@@ -120,6 +130,12 @@ void c_InputArtnet::Process ()
         pArtnet->read ();
     }
 
+    if (SyncMode && ((millis () - LastSyncTimeMs) >= ARTNET_SYNC_TIMEOUT_MS))
+    {
+        ++SyncTimeoutCounter;
+        SetSyncMode (false);
+    }
+
     // DEBUG_END;
 
 } // process
@@ -155,9 +171,28 @@ void c_InputArtnet::onDmxFrame (uint16_t  CurrentUniverseId,
         // DEBUG_V (String ("data[0]: ") + String (data[0], HEX));
 
         lastData = data[0];
-        OutputMgr.WriteChannelData( CurrentUniverse.DestinationOffset, 
-                                 min(CurrentUniverse.BytesToCopy, length), 
-                                 &data[CurrentUniverse.SourceDataOffset]);
+        size_t NumBytes = min (CurrentUniverse.BytesToCopy, length);
+
+        if (SyncMode)
+        {
+            if (0 != CurrentUniverse.BytesStaged)
+            {
+                // the ArtSync for the staged frame never came. Send it now
+                ++LateSyncCounter;
+                CommitStagedFrame ();
+            }
+
+            memcpy (&pStagingBuffer[CurrentUniverse.DestinationOffset],
+                    &data[CurrentUniverse.SourceDataOffset],
+                    NumBytes);
+            CurrentUniverse.BytesStaged = NumBytes;
+        }
+        else
+        {
+            OutputMgr.WriteChannelData( CurrentUniverse.DestinationOffset, 
+                                     NumBytes, 
+                                     &data[CurrentUniverse.SourceDataOffset]);
+        }
 /*
         memcpy(CurrentUniverse.Destination,
                &data[CurrentUniverse.SourceDataOffset],
@@ -171,6 +206,140 @@ void c_InputArtnet::onDmxFrame (uint16_t  CurrentUniverseId,
     }
     // DEBUG_END;
 }
+
+//-----------------------------------------------------------------------------
+/*
+    Art-Net 4: the first ArtSync puts the node in synchronous mode. ArtDmx
+    data is then held until the next ArtSync and sent in one step. An
+    ArtSync from anyone other than the controller sending us ArtDmx is
+    ignored.
+*/
+void c_InputArtnet::onSync (IPAddress remoteIP)
+{
+    // DEBUG_START;
+
+    do // once
+    {
+        if ((uint32_t (LastRemoteIP) != 0) && !(remoteIP == LastRemoteIP))
+        {
+            ++SyncIgnoredCounter;
+            break;
+        }
+
+        LastSyncTimeMs = millis ();
+
+        if (!SyncMode)
+        {
+            // data received so far was sent as it arrived
+            if (!SyncUnavailable)
+            {
+                SetSyncMode (true);
+            }
+            break;
+        }
+
+        ++SyncFrameCounter;
+        CommitStagedFrame ();
+
+    } while (false);
+
+    // DEBUG_END;
+
+} // onSync
+
+//-----------------------------------------------------------------------------
+// Copy the staged universes to the outputs and let them latch the frame.
+void c_InputArtnet::CommitStagedFrame ()
+{
+    // DEBUG_START;
+
+    for (auto & CurrentUniverse : UniverseArray)
+    {
+        if (0 != CurrentUniverse.BytesStaged)
+        {
+            OutputMgr.WriteChannelData (CurrentUniverse.DestinationOffset,
+                                        CurrentUniverse.BytesStaged,
+                                        &pStagingBuffer[CurrentUniverse.DestinationOffset]);
+            CurrentUniverse.BytesStaged = 0;
+        }
+    }
+
+    OutputMgr.LatchFrame ();
+
+    // DEBUG_END;
+
+} // CommitStagedFrame
+
+//-----------------------------------------------------------------------------
+void c_InputArtnet::SetSyncMode (bool NewSyncMode)
+{
+    // DEBUG_START;
+
+    do // once
+    {
+        if (NewSyncMode)
+        {
+            if (nullptr == pStagingBuffer)
+            {
+                pStagingBuffer = (uint8_t*)malloc (InputDataBufferSize);
+            }
+
+            if (nullptr == pStagingBuffer)
+            {
+                logcon (CN_stars + String (F (" No memory for the ArtSync staging buffer. Ignoring ArtSync. ")) + CN_stars);
+                // try again after the next config or buffer change
+                SyncUnavailable = true;
+                break;
+            }
+
+            logcon (String (F ("ArtSync enabled")));
+        }
+        else
+        {
+            // send anything that was waiting for a sync
+            CommitStagedFrame ();
+
+            logcon (String (F ("ArtSync stopped. Sending data as it arrives")));
+        }
+
+        SyncMode = NewSyncMode;
+        OutputMgr.SetExplicitLatch (SyncMode);
+
+    } while (false);
+
+    // DEBUG_END;
+
+} // SetSyncMode
+
+//-----------------------------------------------------------------------------
+// Drop anything staged and go back to sending universes as they arrive.
+void c_InputArtnet::ResetSync ()
+{
+    // DEBUG_START;
+
+    if (SyncMode)
+    {
+        SyncMode = false;
+        OutputMgr.SetExplicitLatch (false);
+    }
+
+    if (nullptr != pStagingBuffer)
+    {
+        free (pStagingBuffer);
+        pStagingBuffer = nullptr;
+    }
+
+    for (auto & CurrentUniverse : UniverseArray)
+    {
+        CurrentUniverse.BytesStaged = 0;
+    }
+
+    SyncUnavailable = false;
+
+    // DEBUG_END;
+
+} // ResetSync
+
 //-----------------------------------------------------------------------------
 void c_InputArtnet::SetBufferInfo (size_t BufferSize)
 {
@@ -196,6 +365,9 @@ void c_InputArtnet::SetBufferTranslation ()
 {
     // DEBUG_START;
 
+    // the staged data no longer lines up with the universes
+    ResetSync ();
+
     // for each possible universe, set the start and size
 
     size_t InputOffset = FirstUniverseChannelOffset - 1;
@@ -278,6 +450,11 @@ void c_InputArtnet::SetUpArtnet ()
                 // logcon ("fMe");
                 fMe->onDmxFrame (UniverseId, length, sequence, data, remoteIP);
             });
+
+        pArtnet->setArtSyncCallback ([](IPAddress remoteIP)
+            {
+                fMe->onSync (remoteIP);
+            });
     }
     // DEBUG_V ("");
 
@@ -52,15 +52,31 @@ class c_InputArtnet : public c_InputCommon
         uint32_t SequenceErrorCounter;
         uint8_t  SequenceNumber;
         uint32_t num_packets;
+        size_t   BytesStaged;       ///< 0 = nothing held for the next ArtSync
 
     } Universe_t;
     Universe_t UniverseArray[MAX_NUM_UNIVERSES];
 
+    /// ArtSync
+#   define ARTNET_SYNC_TIMEOUT_MS 4000 ///< Art-Net 4: drop back to immediate output when ArtSync stops
+    uint8_t   * pStagingBuffer    = nullptr;
+    bool        SyncMode          = false;
+    bool        SyncUnavailable   = false;  ///< No memory to stage a frame. Cleared by ResetSync
+    uint32_t    LastSyncTimeMs    = 0;
+    uint32_t    SyncFrameCounter  = 0;
+    uint32_t    LateSyncCounter   = 0;
+    uint32_t    SyncTimeoutCounter = 0;
+    uint32_t    SyncIgnoredCounter = 0;
+
     void SetUpArtnet ();
     void validateConfiguration ();
     void NetworkStateChanged (bool IsConnected, bool RebootAllowed); // used by poorly designed rx functions
     void SetBufferTranslation ();
     void onDmxFrame (uint16_t CurrentUniverseId, size_t length, uint8_t sequence, uint8_t* data, IPAddress remoteIP);
+    void onSync (IPAddress remoteIP);
+    void SetSyncMode (bool NewSyncMode);
+    void CommitStagedFrame ();
+    void ResetSync ();
 
   public:
 
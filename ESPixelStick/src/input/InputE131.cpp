@@ -32,6 +32,11 @@ c_InputE131::c_InputE131 (c_InputMgr::e_InputChannelIds NewInputChannelId,
     e131 = new ESPAsyncE131 (0);
 
     memset ((void*)UniverseArray, 0x00, sizeof (UniverseArray));
+    memset ((void*)Sources,       0x00, sizeof (Sources));
+
+#ifdef ARDUINO_ARCH_ESP32
+    SyncMutex = xSemaphoreCreateMutex ();
+#endif // def ARDUINO_ARCH_ESP32
 
     // DEBUG_END;
 } // c_InputE131
@@ -41,6 +46,18 @@ c_InputE131::~c_InputE131()
 {
     // DEBUG_START;
 
+    // do not leave the outputs waiting for a sync that will never come
+    ResetSync ();
+    ResetSources ();
+
+#ifdef ARDUINO_ARCH_ESP32
+    if (NULL != SyncMutex)
+    {
+        vSemaphoreDelete (SyncMutex);
+        SyncMutex = NULL;
+    }
+#endif // def ARDUINO_ARCH_ESP32
+
     // DEBUG_END;
 
 } // ~c_InputE131
@@ -82,6 +99,8 @@ void c_InputE131::GetConfig (JsonObject & jsonConfig)
     jsonConfig[CN_universe_limit] = ChannelsPerUniverse;
     jsonConfig[CN_universe_start] = FirstUniverseChannelOffset;
     jsonConfig[CN_port]           = PortId;
+    jsonConfig[CN_synctimeout]    = SyncTimeoutMs;
+    jsonConfig[CN_merge]          = MergeMode;
 
     // DEBUG_END;
 
@@ -114,6 +133,49 @@ void c_InputE131::GetStatus (JsonObject & jsonStatus)
 
     e131Status[CN_packet_errors] = TotalErrors;
 
+    e131Status[F ("SyncMode")]    = SyncMode;
+    e131Status[F ("SyncNoMem")]   = SyncUnavailable;
+    e131Status[F ("SyncAddress")] = LastSyncAddress;
+    e131Status[F ("SyncFrames")]  = SyncFrameCounter;
+    e131Status[F ("SyncLate")]    = LateSyncCounter;
+    e131Status[F ("SyncMissed")]  = MissedSyncCounter;
+
+    e131Status[F ("SourcesDropped")] = SourcesDroppedCounter;
+    JsonArray e131SourceStatus = e131Status.createNestedArray (F ("sources"));
+    uint32_t Now = millis ();
+    uint16_t NumUniverses = LastUniverse - startUniverse + 1;
+
+    LockSync ();
+    for (auto & CurrentSource : Sources)
+    {
+        if (!CurrentSource.InUse)
+        {
+            continue;
+        }
+
+        uint16_t NumActiveUniverses = 0;
+        uint8_t  HighestPriority    = 0;
+        for (uint16_t UniverseIndex = 0; UniverseIndex < NumUniverses; ++UniverseIndex)
+        {
+            if (IsSourceActive (CurrentSource, UniverseIndex, Now))
+            {
+                ++NumActiveUniverses;
+                HighestPriority = max (HighestPriority, CurrentSource.Priority[UniverseIndex]);
+            }
+        }
+
+        if (0 == NumActiveUniverses)
+        {
+            continue;
+        }
+
+        JsonObject e131CurrentSourceStatus = e131SourceStatus.createNestedObject ();
+        e131CurrentSourceStatus[CN_name]            = String (CurrentSource.Name);
+        e131CurrentSourceStatus[F ("priority")]     = HighestPriority;
+        e131CurrentSourceStatus[F ("universes")]    = NumActiveUniverses;
+    }
+    UnlockSync ();
+
     // DEBUG_END;
 
 } // GetStatus
@@ -123,6 +185,20 @@ void c_InputE131::Process ()
 {
     // DEBUG_START;
 
+    // a frame that never completes still has to go out
+    if (SyncMode && (0 != NumUniversesStaged))
+    {
+        LockSync ();
+
+        if ((0 != NumUniversesStaged) && ((millis () - FirstStagedTimeMs) >= SyncTimeoutMs))
+        {
+            ++MissedSyncCounter;
+            CommitStagedFrame ();
+        }
+
+        UnlockSync ();
+    }
+
     // DEBUG_END;
 
 } // process
@@ -151,46 +227,569 @@ void c_InputE131::ProcessIncomingE131Data (e131_packet_t * packet)
 
         if ((startUniverse <= CurrentUniverseId) && (LastUniverse >= CurrentUniverseId))
         {
-            // Universe offset and sequence tracking
-            Universe_t& CurrentUniverse = UniverseArray[CurrentUniverseId - startUniverse];
+            uint16_t    UniverseIndex = CurrentUniverseId - startUniverse;
+            Universe_t& CurrentUniverse = UniverseArray[UniverseIndex];
+            uint32_t    Now = millis ();
+
+            LockSync ();
+
+            do // once
+            {
+                Source_t * pSource = FindSource (packet, Now);
+                if (nullptr == pSource)
+                {
+                    // no room to track another source
+                    ++SourcesDroppedCounter;
+                    break;
+                }
+
+                if (packet->options & E131_OPTION_STREAM_TERMINATED)
+                {
+                    // the source is leaving. The data in this packet must be ignored
+                    pSource->Active[UniverseIndex] = false;
+                    break;
+                }
+
+                // sequence tracking is per source. A source that is (re)starting sets it
+                if (!IsSourceActive (*pSource, UniverseIndex, Now))
+                {
+                    pSource->SequenceNumber[UniverseIndex] = packet->sequence_number;
+                }
+
+                // Do we need to update a sequnce error?
+                if (packet->sequence_number != pSource->SequenceNumber[UniverseIndex])
+                {
+                    // DEBUG_V (F ("E1.31 Sequence Error - expected: "));
+                    // DEBUG_V (pSource->SequenceNumber[UniverseIndex]);
+                    // DEBUG_V (F (" actual: "));
+                    // DEBUG_V (packet->sequence_number);
+                    // DEBUG_V (" " + String (CN_universe) + " : ");
+                    // DEBUG_V (CurrentUniverseId);
+
+                    CurrentUniverse.SequenceErrorCounter++;
+                    pSource->SequenceNumber[UniverseIndex] = packet->sequence_number;
+                }
+
+                ++pSource->SequenceNumber[UniverseIndex];
+
+                pSource->Priority[UniverseIndex]   = packet->priority;
+                pSource->LastSeenMs[UniverseIndex] = Now;
+                pSource->Active[UniverseIndex]     = true;
+
+                size_t NumBytesOfE131Data = size_t(ntohs (packet->property_value_count) - 1);
+                size_t NumBytes = min (CurrentUniverse.BytesToCopy, NumBytesOfE131Data);
+                uint8_t * pData = ArbitrateSources (*pSource, UniverseIndex, &E131Data[CurrentUniverse.SourceDataOffset], NumBytes, Now);
+                if (nullptr == pData)
+                {
+                    // a higher priority source owns this universe
+                    break;
+                }
+
+                // E1.31-2016 renamed the reserved field to the Synchronization Address
+                uint16_t SyncAddress = (0 == SyncTimeoutMs) ? 0 : ntohs (packet->reserved);
+
+                if (((0 != SyncAddress) != SyncMode) && !SyncUnavailable)
+                {
+                    SetSyncMode (0 != SyncAddress);
+                }
+                LastSyncAddress = SyncAddress;
+
+                if (SyncMode)
+                {
+                    StageUniverse (CurrentUniverse, pData, NumBytes);
+                }
+                else
+                {
+                    OutputMgr.WriteChannelData (CurrentUniverse.DestinationOffset, NumBytes, pData);
+                }
+
+                InputMgr.RestartBlankTimer (GetInputChannelId ());
+
+            } while (false);
+
+            UnlockSync ();
+        }
+        else
+        {
+            // DEBUG_V ("Not interested in this universe");
+        }
+
+    } while (false);
+
+    // DEBUG_END;
+
+} // process
+
+//-----------------------------------------------------------------------------
+/*
+    Highest Takes Precedence merge of two blocks of channel data. Each byte
+    of Destination becomes the larger of itself and the matching byte of
+    Source. Four channels are compared per operation. The compare is done
+    on the low seven bits with bit 7 forced on so a borrow can never cross
+    into the next byte, then fixed up using the real top bits.
+*/
+static void MaxBytes (uint32_t * Destination, const uint32_t * Source, size_t NumWords)
+{
+    const uint32_t HighBits = 0x80808080;
+
+    while (NumWords--)
+    {
+        uint32_t a = *Destination;
+        uint32_t b = *Source++;
+
+        uint32_t LowBitsGreaterOrEqual = (a | HighBits) - (b & ~HighBits);
+        uint32_t GreaterOrEqual = ((a & ~b) | (~(a ^ b) & LowBitsGreaterOrEqual)) & HighBits;
+        uint32_t UseA = (GreaterOrEqual >> 7) * 0xFF;
+
+        *Destination++ = (a & UseA) | (b & ~UseA);
+    }
+
+} // MaxBytes
+
+//-----------------------------------------------------------------------------
+bool c_InputE131::IsSourceActive (Source_t & Source, uint16_t UniverseIndex, uint32_t Now)
+{
+    return Source.Active[UniverseIndex] && ((Now - Source.LastSeenMs[UniverseIndex]) < E131_SOURCE_TIMEOUT_MS);
+
+} // IsSourceActive
+
+//-----------------------------------------------------------------------------
+/*
+    Find the entry for the CID that sent this packet or make a new one.
+    Entries with no universe heard from in E131_SOURCE_TIMEOUT_MS are
+    released. Per source data buffers only exist while more than one
+    source is known, so a single sender costs no extra memory.
+    Must be called with the sync lock held.
+*/
+c_InputE131::Source_t * c_InputE131::FindSource (e131_packet_t * packet, uint32_t Now)
+{
+    // DEBUG_START;
+
+    Source_t * pResponse = nullptr;
+
+    do // once
+    {
+        for (auto & CurrentSource : Sources)
+        {
+            if (CurrentSource.InUse && (0 == memcmp (CurrentSource.Cid, packet->cid, sizeof (CurrentSource.Cid))))
+            {
+                pResponse = &CurrentSource;
+                break;
+            }
+        }
+
+        if (nullptr != pResponse)
+        {
+            break;
+        }
+
+        // new source. Release the ones that have gone quiet and look for room
+        uint16_t   NumUniverses    = LastUniverse - startUniverse + 1;
+        uint8_t    NumSourcesInUse = 0;
+        Source_t * pFreeSource     = nullptr;
+
+        for (auto & CurrentSource : Sources)
+        {
+            bool SourceIsActive = false;
+            for (uint16_t UniverseIndex = 0; CurrentSource.InUse && (UniverseIndex < NumUniverses); ++UniverseIndex)
+            {
+                if (IsSourceActive (CurrentSource, UniverseIndex, Now))
+                {
+                    SourceIsActive = true;
+                    break;
+                }
+            }
+
+            if (SourceIsActive)
+            {
+                ++NumSourcesInUse;
+                continue;
+            }
+
+            if (CurrentSource.InUse)
+            {
+                logcon (String (F ("E1.31 source timed out: ")) + CurrentSource.Name);
+                free (CurrentSource.pData);
+                CurrentSource.pData = nullptr;
+                CurrentSource.InUse = false;
+            }
+
+            if (nullptr == pFreeSource)
+            {
+                pFreeSource = &CurrentSource;
+            }
+        }
+
+        if (nullptr == pFreeSource)
+        {
+            break;
+        }
+
+        memset ((void*)pFreeSource, 0x00, sizeof (Source_t));
+        memcpy (pFreeSource->Cid,  packet->cid,         sizeof (pFreeSource->Cid));
+        memcpy (pFreeSource->Name, packet->source_name, sizeof (pFreeSource->Name) - 1);
+        pFreeSource->InUse = true;
+        ++NumSourcesInUse;
+
+        logcon (String (F ("E1.31 source: ")) + pFreeSource->Name);
+
+        // the merge needs the last data from every source
+        for (auto & CurrentSource : Sources)
+        {
+            if ((NumSourcesInUse < 2) || !CurrentSource.InUse || (nullptr != CurrentSource.pData))
+            {
+                continue;
+            }
 
-            // Do we need to update a sequnce error?
-            if (packet->sequence_number != CurrentUniverse.SequenceNumber)
+            CurrentSource.pData = (uint8_t*)calloc (NumUniverses, UNIVERSE_MAX);
+            if (nullptr == CurrentSource.pData)
             {
-                // DEBUG_V (F ("E1.31 Sequence Error - expected: "));
-                // DEBUG_V (CurrentUniverse.SequenceNumber);
-                // DEBUG_V (F (" actual: "));
-                // DEBUG_V (packet->sequence_number);
-                // DEBUG_V (" " + String (CN_universe) + " : ");
-                // DEBUG_V (CurrentUniverseId);
-
-                CurrentUniverse.SequenceErrorCounter++;
-                CurrentUniverse.SequenceNumber = packet->sequence_number;
+                logcon (CN_stars + String (F (" No memory to merge E1.31 source: ")) + CurrentSource.Name + " " + CN_stars);
+                continue;
             }
 
-            ++CurrentUniverse.SequenceNumber;
+            if (&CurrentSource != pFreeSource)
+            {
+                SeedSourceData (CurrentSource, NumUniverses);
+            }
+        }
 
-            size_t NumBytesOfE131Data = size_t(ntohs (packet->property_value_count) - 1);
-            OutputMgr.WriteChannelData(CurrentUniverse.DestinationOffset, 
-                                    min(CurrentUniverse.BytesToCopy, NumBytesOfE131Data), 
-                                    &E131Data[CurrentUniverse.SourceDataOffset]);
+        pResponse = pFreeSource;
+
+    } while (false);
+
+    // DEBUG_END;
+
+    return pResponse;
+
+} // FindSource
+
+//-----------------------------------------------------------------------------
 /*
-            memcpy(CurrentUniverse.Destination, 
-                   &E131Data[CurrentUniverse.SourceDataOffset],
-                   min(CurrentUniverse.BytesToCopy, NumBytesOfE131Data));
+    A source that was sending on its own has not kept a copy of its data.
+    What it sent last is what the universes hold now (or what is staged for
+    the next synchronized frame), so start from that instead of zeros.
+    Otherwise an HTP merge dips until the source sends each universe again.
+    Must be called with the sync lock held.
 */
-            InputMgr.RestartBlankTimer (GetInputChannelId ());
+void c_InputE131::SeedSourceData (Source_t & Source, uint16_t NumUniverses)
+{
+    // DEBUG_START;
+
+    for (uint16_t UniverseIndex = 0; UniverseIndex < NumUniverses; ++UniverseIndex)
+    {
+        Universe_t & CurrentUniverse = UniverseArray[UniverseIndex];
+        uint8_t    * pTarget         = &Source.pData[size_t (UniverseIndex) * UNIVERSE_MAX];
+
+        if ((nullptr != pStagingBuffer) && (0 != CurrentUniverse.BytesStaged))
+        {
+            memcpy (pTarget, &pStagingBuffer[CurrentUniverse.DestinationOffset], CurrentUniverse.BytesStaged);
         }
         else
         {
-            // DEBUG_V ("Not interested in this universe");
+            OutputMgr.ReadChannelData (CurrentUniverse.DestinationOffset, CurrentUniverse.BytesToCopy, pTarget);
         }
+    }
+
+    // DEBUG_END;
+
+} // SeedSourceData
+
+//-----------------------------------------------------------------------------
+/*
+    Decide what a universe should show after a packet from CurrentSource.
+    The highest priority source that has not timed out owns the universe.
+    Lower priority packets are dropped (nullptr is returned). Equal
+    priority sources are merged per MergeMode:
+        LTP - the packet that arrived last wins
+        HTP - each channel takes the highest value of any of the sources
+    Must be called with the sync lock held.
+*/
+uint8_t * c_InputE131::ArbitrateSources (Source_t & CurrentSource, uint16_t UniverseIndex, uint8_t * pData, size_t NumBytes, uint32_t Now)
+{
+    // DEBUG_START;
+
+    uint8_t * pResponse = pData;
+
+    do // once
+    {
+        size_t UniverseOffset = size_t (UniverseIndex) * UNIVERSE_MAX;
+
+        if (nullptr != CurrentSource.pData)
+        {
+            memcpy (&CurrentSource.pData[UniverseOffset], pData, NumBytes);
+        }
+
+        uint8_t TopPriority     = 0;
+        uint8_t NumSourcesAtTop = 0;
+        for (auto & Source : Sources)
+        {
+            if (!Source.InUse || !IsSourceActive (Source, UniverseIndex, Now))
+            {
+                continue;
+            }
+
+            if (Source.Priority[UniverseIndex] > TopPriority)
+            {
+                TopPriority     = Source.Priority[UniverseIndex];
+                NumSourcesAtTop = 1;
+            }
+            else if (Source.Priority[UniverseIndex] == TopPriority)
+            {
+                ++NumSourcesAtTop;
+            }
+        }
+
+        if (CurrentSource.Priority[UniverseIndex] < TopPriority)
+        {
+            pResponse = nullptr;
+            break;
+        }
+
+        if ((1 == NumSourcesAtTop) || (E131_MERGE_LTP == MergeMode))
+        {
+            break;
+        }
+
+        // HTP merge of everyone at the top priority
+        memcpy ((void*)MergeBuffer, pData, NumBytes);
+        size_t NumWords = (NumBytes + sizeof (uint32_t) - 1) / sizeof (uint32_t);
+
+        for (auto & Source : Sources)
+        {
+            if ((&Source == &CurrentSource) ||
+                !Source.InUse ||
+                (nullptr == Source.pData) ||
+                !IsSourceActive (Source, UniverseIndex, Now) ||
+                (Source.Priority[UniverseIndex] != TopPriority))
+            {
+                continue;
+            }
+
+            MaxBytes (MergeBuffer, (uint32_t*)&Source.pData[UniverseOffset], NumWords);
+        }
+
+        pResponse = (uint8_t*)MergeBuffer;
 
     } while (false);
 
     // DEBUG_END;
 
-} // process
+    return pResponse;
+
+} // ArbitrateSources
+
+//-----------------------------------------------------------------------------
+void c_InputE131::ResetSources ()
+{
+    // DEBUG_START;
+
+    LockSync ();
+
+    for (auto & CurrentSource : Sources)
+    {
+        free (CurrentSource.pData);
+        memset ((void*)&CurrentSource, 0x00, sizeof (CurrentSource));
+    }
+
+    UnlockSync ();
+
+    // DEBUG_END;
+
+} // ResetSources
+
+//-----------------------------------------------------------------------------
+/*
+    The ESPAsyncE131 library drops E1.31 sync packets (root vector 0x08)
+    before they reach us. So we cannot act on the sync packet itself.
+    Universes that name a sync address are staged instead. The staged
+    frame is committed to the outputs in one step when:
+        - every universe that made up the last frame has arrived again
+        - a universe repeats before that (the sender moved on. Late sync)
+        - SyncTimeoutMs passes without either (missed sync)
+    The outputs run with an explicit latch while we are in sync mode, so
+    they never send a frame that is half old and half new.
+
+    Must be called with the sync lock held.
+*/
+void c_InputE131::StageUniverse (Universe_t & CurrentUniverse, uint8_t * pData, size_t NumBytes)
+{
+    // DEBUG_START;
+
+    do // once
+    {
+        if (0 == NumBytes)
+        {
+            // nothing we can use
+            break;
+        }
+
+        if (0 != CurrentUniverse.BytesStaged)
+        {
+            // this universe already belongs to the frame being staged
+            ++LateSyncCounter;
+            CommitStagedFrame ();
+        }
+
+        memcpy (&pStagingBuffer[CurrentUniverse.DestinationOffset], pData, NumBytes);
+        CurrentUniverse.BytesStaged = NumBytes;
+
+        if (0 == NumUniversesStaged)
+        {
+            FirstStagedTimeMs = millis ();
+        }
+        ++NumUniversesStaged;
+
+        if (CurrentUniverse.ExpectedInFrame)
+        {
+            ++NumExpectedStaged;
+        }
+
+        if ((0 != NumUniversesExpected) && (NumExpectedStaged >= NumUniversesExpected))
+        {
+            ++SyncFrameCounter;
+            CommitStagedFrame ();
+        }
+
+    } while (false);
+
+    // DEBUG_END;
+
+} // StageUniverse
+
+//-----------------------------------------------------------------------------
+/*
+    Copy the staged universes to the outputs and let them latch the frame.
+    Whatever made up this frame is what we expect the next frame to hold.
+    Must be called with the sync lock held.
+*/
+void c_InputE131::CommitStagedFrame ()
+{
+    // DEBUG_START;
+
+    NumUniversesExpected = 0;
+
+    for (auto & CurrentUniverse : UniverseArray)
+    {
+        CurrentUniverse.ExpectedInFrame = (0 != CurrentUniverse.BytesStaged);
+        if (CurrentUniverse.ExpectedInFrame)
+        {
+            OutputMgr.WriteChannelData (CurrentUniverse.DestinationOffset,
+                                        CurrentUniverse.BytesStaged,
+                                        &pStagingBuffer[CurrentUniverse.DestinationOffset]);
+            CurrentUniverse.BytesStaged = 0;
+            ++NumUniversesExpected;
+        }
+    }
+
+    NumUniversesStaged = 0;
+    NumExpectedStaged  = 0;
+
+    OutputMgr.LatchFrame ();
+
+    // DEBUG_END;
+
+} // CommitStagedFrame
+
+//-----------------------------------------------------------------------------
+// Must be called with the sync lock held.
+void c_InputE131::SetSyncMode (bool NewSyncMode)
+{
+    // DEBUG_START;
+
+    do // once
+    {
+        if (NewSyncMode)
+        {
+            if (nullptr == pStagingBuffer)
+            {
+                pStagingBuffer = (uint8_t*)malloc (InputDataBufferSize);
+            }
+
+            if (nullptr == pStagingBuffer)
+            {
+                logcon (CN_stars + String (F (" No memory for the E1.31 sync staging buffer. Ignoring sync. ")) + CN_stars);
+                // try again after the next config or buffer change
+                SyncUnavailable = true;
+                break;
+            }
+
+            logcon (String (F ("E1.31 sync enabled")));
+        }
+        else
+        {
+            // send anything that was waiting for a sync
+            if (0 != NumUniversesStaged)
+            {
+                CommitStagedFrame ();
+            }
+            NumUniversesExpected = 0;
+
+            logcon (String (F ("E1.31 sync disabled")));
+        }
+
+        SyncMode = NewSyncMode;
+        OutputMgr.SetExplicitLatch (SyncMode);
+
+    } while (false);
+
+    // DEBUG_END;
+
+} // SetSyncMode
+
+//-----------------------------------------------------------------------------
+// Drop anything staged and go back to sending universes as they arrive.
+void c_InputE131::ResetSync ()
+{
+    // DEBUG_START;
+
+    LockSync ();
+
+    if (SyncMode)
+    {
+        SyncMode = false;
+        OutputMgr.SetExplicitLatch (false);
+    }
+
+    if (nullptr != pStagingBuffer)
+    {
+        free (pStagingBuffer);
+        pStagingBuffer = nullptr;
+    }
+
+    for (auto & CurrentUniverse : UniverseArray)
+    {
+        CurrentUniverse.BytesStaged     = 0;
+        CurrentUniverse.ExpectedInFrame = false;
+    }
+
+    NumUniversesStaged   = 0;
+    NumExpectedStaged    = 0;
+    NumUniversesExpected = 0;
+    SyncUnavailable      = false;
+
+    UnlockSync ();
+
+    // DEBUG_END;
+
+} // ResetSync
+
+//-----------------------------------------------------------------------------
+void c_InputE131::LockSync ()
+{
+#ifdef ARDUINO_ARCH_ESP32
+    // packets arrive on the AsyncUDP task while Process and GetStatus run on others
+    xSemaphoreTake (SyncMutex, portMAX_DELAY);
+#endif // def ARDUINO_ARCH_ESP32
+} // LockSync
+
+//-----------------------------------------------------------------------------
+void c_InputE131::UnlockSync ()
+{
+#ifdef ARDUINO_ARCH_ESP32
+    xSemaphoreGive (SyncMutex);
+#endif // def ARDUINO_ARCH_ESP32
+} // UnlockSync
 
 //-----------------------------------------------------------------------------
 void c_InputE131::SetBufferInfo (size_t BufferSize)
@@ -217,6 +816,10 @@ void c_InputE131::SetBufferTranslation ()
 {
     // DEBUG_START;
 
+    // the staged and per source data no longer line up with the universes
+    ResetSync ();
+    ResetSources ();
+
     // for each possible universe, set the start and size
 
     size_t InputOffset = FirstUniverseChannelOffset - 1;
@@ -236,7 +839,6 @@ void c_InputE131::SetBufferTranslation ()
         CurrentUniverse.BytesToCopy = BytesInThisUniverse;
         CurrentUniverse.SourceDataOffset = InputOffset;
         CurrentUniverse.SequenceErrorCounter = 0;
-        CurrentUniverse.SequenceNumber = 0;
 
         // DEBUG_V (String ("        Destination: 0x") + String (uint32_t (CurrentUniverse.Destination), HEX));
         // DEBUG_V (String ("        BytesToCopy:   ") + String (CurrentUniverse.BytesToCopy));
@@ -269,6 +871,8 @@ bool c_InputE131::SetConfig (ArduinoJson::JsonObject& jsonConfig)
     setFromJSON (ChannelsPerUniverse,        jsonConfig, CN_universe_limit);
     setFromJSON (FirstUniverseChannelOffset, jsonConfig, CN_universe_start);
     setFromJSON (PortId,                     jsonConfig, CN_port);
+    setFromJSON (SyncTimeoutMs,              jsonConfig, CN_synctimeout);
+    setFromJSON (MergeMode,                  jsonConfig, CN_merge);
 
     if ((OldPortId != PortId) && (ESPAsyncE131Initialized))
     {
@@ -325,6 +929,18 @@ void c_InputE131::validateConfiguration ()
         FirstUniverseChannelOffset = ChannelsPerUniverse - 1;
     }
 
+    if (MergeMode > E131_MERGE_HTP)
+    {
+        // DEBUG_V (String ("ERROR: MergeMode: ") + String (MergeMode));
+        MergeMode = E131_MERGE_HTP;
+    }
+
+    if (SyncTimeoutMs > E131_MAX_SYNC_TIMEOUT_MS)
+    {
+        // DEBUG_V (String ("ERROR: SyncTimeoutMs: ") + String (SyncTimeoutMs));
+        SyncTimeoutMs = E131_MAX_SYNC_TIMEOUT_MS;
+    }
+
     // Find the last universe we should listen for
      // DEBUG_V ("");
     size_t span = FirstUniverseChannelOffset + InputDataBufferSize - 1;
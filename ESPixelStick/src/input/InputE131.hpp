@@ -38,6 +38,8 @@ class c_InputE131 : public c_InputCommon
     uint16_t    FirstUniverseChannelOffset = 1;    ///< Channel to start listening at - 1 based
     ESPAsyncE131PortId PortId              = E131_DEFAULT_PORT;
     bool        ESPAsyncE131Initialized    = false;
+    uint16_t    SyncTimeoutMs              = 100;  ///< Longest a synchronized frame is held back. 0 = ignore sync addresses
+    uint8_t     MergeMode                  = 1;    ///< How equal priority sources are combined. 0 = LTP, 1 = HTP
 
     /// from sketch globals
     uint16_t    channel_count = 0;       ///< Number of channels. Derived from output module configuration.
@@ -47,15 +49,71 @@ class c_InputE131 : public c_InputCommon
       size_t   DestinationOffset;
       size_t   BytesToCopy;
       size_t   SourceDataOffset;
-      uint8_t  SequenceNumber;
       uint32_t SequenceErrorCounter;
+      size_t   BytesStaged;       ///< 0 = nothing held for the next synchronized frame
+      bool     ExpectedInFrame;   ///< was part of the last synchronized frame
 
     } Universe_t;
     Universe_t UniverseArray[MAX_NUM_UNIVERSES];
 
+    /// Sources are told apart by their CID. The highest priority source
+    /// that is still sending owns a universe.
+#   define E131_MERGE_LTP               0
+#   define E131_MERGE_HTP               1
+#   define E131_SOURCE_TIMEOUT_MS       2500 ///< E1.31 network data loss timeout
+#   define E131_OPTION_STREAM_TERMINATED 0x40
+#ifdef ARDUINO_ARCH_ESP32
+#   define E131_MAX_SOURCES             3
+#else
+#   define E131_MAX_SOURCES             2
+#endif // def ARDUINO_ARCH_ESP32
+    typedef struct
+    {
+      bool     InUse;
+      uint8_t  Cid[16];
+      char     Name[64];
+      uint8_t  Priority[MAX_NUM_UNIVERSES];
+      uint8_t  SequenceNumber[MAX_NUM_UNIVERSES];
+      bool     Active[MAX_NUM_UNIVERSES];
+      uint32_t LastSeenMs[MAX_NUM_UNIVERSES];
+      uint8_t* pData;             ///< UNIVERSE_MAX bytes per universe. Only allocated while there is more than one source
+
+    } Source_t;
+    Source_t    Sources[E131_MAX_SOURCES];
+    uint32_t    MergeBuffer[UNIVERSE_MAX / sizeof (uint32_t)];
+    uint32_t    SourcesDroppedCounter   = 0;
+
+    /// E1.31-2016 synchronization
+#   define E131_MAX_SYNC_TIMEOUT_MS 2500 ///< receivers drop out of sync mode after 2.5 seconds without sync
+    uint8_t   * pStagingBuffer          = nullptr;
+    bool        SyncMode                = false;
+    bool        SyncUnavailable         = false;  ///< No memory to stage a frame. Cleared by ResetSync
+    uint16_t    LastSyncAddress         = 0;
+    uint16_t    NumUniversesStaged      = 0;
+    uint16_t    NumExpectedStaged       = 0;
+    uint16_t    NumUniversesExpected    = 0;
+    uint32_t    FirstStagedTimeMs       = 0;
+    uint32_t    SyncFrameCounter        = 0;
+    uint32_t    LateSyncCounter         = 0;
+    uint32_t    MissedSyncCounter       = 0;
+#ifdef ARDUINO_ARCH_ESP32
+    SemaphoreHandle_t SyncMutex         = NULL;
+#endif // def ARDUINO_ARCH_ESP32
+
     void validateConfiguration ();
     void NetworkStateChanged (bool IsConnected, bool RebootAllowed); // used by poorly designed rx functions
     void SetBufferTranslation ();
+    void SetSyncMode (bool NewSyncMode);
+    void StageUniverse (Universe_t & CurrentUniverse, uint8_t * pData, size_t NumBytes);
+    void CommitStagedFrame ();
+    void ResetSync ();
+    Source_t * FindSource (e131_packet_t * packet, uint32_t Now);
+    void SeedSourceData (Source_t & Source, uint16_t NumUniverses);
+    bool IsSourceActive (Source_t & Source, uint16_t UniverseIndex, uint32_t Now);
+    uint8_t * ArbitrateSources (Source_t & CurrentSource, uint16_t UniverseIndex, uint8_t * pData, size_t NumBytes, uint32_t Now);
+    void ResetSources ();
+    void LockSync ();
+    void UnlockSync ();
 
   public:
 
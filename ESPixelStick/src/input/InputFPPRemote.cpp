@@ -164,7 +164,10 @@ bool c_InputFPPRemote::SetConfig (JsonObject& jsonConfig)
 
     // DEBUG_V ("Config Processing");
     // Clear outbuffer on config change
+    OutputMgr.LockBuffer ();
     memset (OutputMgr.GetBufferAddress (), 0x0, OutputMgr.GetBufferUsedSize ());
+    OutputMgr.MarkBufferDirty ();
+    OutputMgr.UnlockBuffer ();
     StartPlaying (FileToPlay);
 
     // DEBUG_END;
@@ -121,7 +121,7 @@ void fsm_PlayEffect_state_PlayingEffect::Poll ()
 {
     // DEBUG_START;
 
-    p_InputFPPRemotePlayEffect->EffectsEngine.SetBufferInfo (OutputMgr.GetBufferUsedSize());
+    p_InputFPPRemotePlayEffect->EffectsEngine.SetBufferInfo (OutputMgr.GetInputChannelCount());
     p_InputFPPRemotePlayEffect->EffectsEngine.Process ();
 
     if (p_InputFPPRemotePlayEffect->PlayEffectEndTime <= millis ())
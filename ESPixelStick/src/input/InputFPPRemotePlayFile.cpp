@@ -470,31 +470,45 @@ void c_InputFPPRemotePlayFile::ClearFileInfo()
 size_t c_InputFPPRemotePlayFile::ReadFile(size_t DestinationIntensityId, size_t NumBytesToRead, size_t FileOffset)
 {
     // DEBUG_START;
-#define WRITE_DIRECT_TO_OUTPUT_BUFFER
-#ifdef WRITE_DIRECT_TO_OUTPUT_BUFFER
-    size_t NumBytesRead = FileMgr.ReadSdFile(FileHandleForFileBeingPlayed,
-                                             OutputMgr.GetBufferAddress(),
-                                             min((NumBytesToRead), OutputMgr.GetBufferUsedSize()),
-                                             FileOffset);
-#else
-    uint8_t LocalIntensityBuffer[200];
-
     size_t NumBytesRead = 0;
 
-    while (NumBytesRead < NumBytesToRead)
+    if (!OutputMgr.IsPatched ())
+    {
+        // input channels are the output buffer. Read straight into it.
+        // Hold the buffer so a reconfig cannot replace it under the read
+        OutputMgr.LockBuffer ();
+        NumBytesRead = FileMgr.ReadSdFile(FileHandleForFileBeingPlayed,
+                                          OutputMgr.GetBufferAddress(),
+                                          min((NumBytesToRead), OutputMgr.GetBufferUsedSize()),
+                                          FileOffset);
+        OutputMgr.MarkBufferDirty ();
+        OutputMgr.UnlockBuffer ();
+    }
+    else
     {
-        size_t NumBytesReadThisPass = FileMgr.ReadSdFile(FileHandleForFileBeingPlayed,
-                                                         LocalIntensityBuffer,
-                                                         min((NumBytesToRead - NumBytesRead), sizeof(LocalIntensityBuffer)),
-                                                         FileOffset);
+        // the patch table has to be applied so the data goes through WriteChannelData
+        uint8_t LocalIntensityBuffer[200];
+        size_t InputChannelCount = OutputMgr.GetInputChannelCount ();
+        NumBytesToRead = (DestinationIntensityId < InputChannelCount) ? min (NumBytesToRead, InputChannelCount - DestinationIntensityId) : 0;
 
-        OutputMgr.WriteChannelData(DestinationIntensityId, NumBytesReadThisPass, LocalIntensityBuffer);
+        while (NumBytesRead < NumBytesToRead)
+        {
+            size_t NumBytesReadThisPass = FileMgr.ReadSdFile(FileHandleForFileBeingPlayed,
+                                                             LocalIntensityBuffer,
+                                                             min((NumBytesToRead - NumBytesRead), sizeof(LocalIntensityBuffer)),
+                                                             FileOffset);
+            if (0 == NumBytesReadThisPass)
+            {
+                break;
+            }
 
-        FileOffset += NumBytesReadThisPass;
-        NumBytesRead += NumBytesReadThisPass;
-        DestinationIntensityId += NumBytesReadThisPass;
+            OutputMgr.WriteChannelData(DestinationIntensityId, NumBytesReadThisPass, LocalIntensityBuffer);
+
+            FileOffset += NumBytesReadThisPass;
+            NumBytesRead += NumBytesReadThisPass;
+            DestinationIntensityId += NumBytesReadThisPass;
+        }
     }
-#endif // !def WRITE_DIRECT_TO_OUTPUT_BUFFER
 
     // DEBUG_END;
     return NumBytesRead;
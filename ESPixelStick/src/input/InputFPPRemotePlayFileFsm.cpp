@@ -240,7 +240,7 @@ IRAM_ATTR void fsm_PlayFile_state_PlayingFile::TimerPoll ()
         }
 
         uint32_t FilePosition = p_Parent->FrameControl.DataOffset + (p_Parent->FrameControl.ChannelsPerFrame * CurrentFrame);
-        size_t BufferSize = OutputMgr.GetBufferUsedSize();
+        size_t BufferSize = OutputMgr.GetInputChannelCount();
         size_t MaxBytesToRead = (p_Parent->FrameControl.ChannelsPerFrame > BufferSize) ? BufferSize : p_Parent->FrameControl.ChannelsPerFrame;
 
         size_t CurrentDestination = 0;
@@ -50,6 +50,7 @@ protected:
 #define APA102_MICRO_SEC_PER_INTENSITY  int ( ( (1.0/float (APA102_BIT_RATE)) * APA102_BITS_PER_INTENSITY))
 #define APA102_MIN_IDLE_TIME_US         500
     uint16_t       BlockSize = 1;
+    uint32_t       BitRate = APA102_BIT_RATE;     ///< Clock of the driver sending the data
     float          BlockDelay = 0;
     const uint32_t FrameStartData = 0;
     const uint32_t FrameEndData = 0xFFFFFFFF;
@@ -71,6 +71,7 @@ void c_OutputAPA102Spi::GetConfig (ArduinoJson::JsonObject& jsonConfig)
     // DEBUG_START;
 
     c_OutputAPA102::GetConfig (jsonConfig);
+    Spi.GetConfig (jsonConfig);
 
     jsonConfig[CN_clock_pin] = DEFAULT_SPI_CLOCK_GPIO;
 
@@ -82,6 +83,12 @@ bool c_OutputAPA102Spi::SetConfig (ArduinoJson::JsonObject& jsonConfig)
 {
     // DEBUG_START;
 
+    Spi.SetConfig (jsonConfig);
+
+    // the frame timing follows the mode and clock of the SPI driver
+    BitRate   = Spi.GetClockHz ();
+    BlockSize = Spi.GetBlockSize ();
+
     bool response = c_OutputAPA102::SetConfig (jsonConfig);
 
     // DEBUG_END;
@@ -89,6 +96,17 @@ bool c_OutputAPA102Spi::SetConfig (ArduinoJson::JsonObject& jsonConfig)
 
 } // GetStatus
 
+//----------------------------------------------------------------------------
+void c_OutputAPA102Spi::GetStatus (ArduinoJson::JsonObject& jsonStatus)
+{
+    // DEBUG_START;
+
+    c_OutputAPA102::GetStatus (jsonStatus);
+    Spi.GetStatus (jsonStatus);
+
+    // DEBUG_END;
+} // GetStatus
+
 //----------------------------------------------------------------------------
 void c_OutputAPA102Spi::Render ()
 {
@@ -96,10 +114,8 @@ void c_OutputAPA102Spi::Render ()
 
     if (canRefresh ())
     {
-        if (Spi.Render ())
-        {
-            ReportNewFrame ();
-        }
+        // the pixel data source reports the new frame
+        Spi.Render ();
     }
 
     // DEBUG_END;
@@ -41,6 +41,7 @@ public:
     // functions to be provided by the derived class
     void    Begin ();
     void    GetConfig (ArduinoJson::JsonObject& jsonConfig);
+    void    GetStatus (ArduinoJson::JsonObject& jsonStatus);
     bool    SetConfig (ArduinoJson::JsonObject& jsonConfig);  ///< Set a new config in the driver
     void    Render ();                                        ///< Call from loop (),  renders output data
     void    PauseOutput () {};
@@ -37,6 +37,8 @@ c_OutputCommon::c_OutputCommon (c_OutputMgr::e_OutputChannelIds _OutputChannelId
 	UartId                   = uart;
     OutputType               = outputType;
     pOutputBuffer            = OutputMgr.GetBufferAddress ();
+    pFrameBuffer             = OutputMgr.GetFrameBufferAddress ();
+    pLatchSource             = pOutputBuffer;
     FrameStartTimeInMicroSec = 0;
 
 	// logcon (String ("UartId:          '") + UartId + "'");
@@ -60,6 +62,7 @@ void c_OutputCommon::ClearBuffer ()
     // DEBUG_START;
 
     memset(GetBufferAddress(), 0x00, GetBufferUsedSize());
+    MarkBufferDirty ();
 
     // DEBUG_END;
 } // ClearBuffer
@@ -73,6 +76,9 @@ void c_OutputCommon::GetStatus (JsonObject & jsonStatus)
     jsonStatus["framerefreshrate"] = (0 == FrameRefreshTimeInMicroSec) ? 0 : int(MicroSecondsInASecond / FrameRefreshTimeInMicroSec);
     jsonStatus["FrameCount"] = FrameCount;
 
+    JsonObject TelemetryStatus = jsonStatus.createNestedObject (F ("Telemetry"));
+    Telemetry.GetStatus (TelemetryStatus);
+
     // DEBUG_END;
 } // GetStatus
 
@@ -81,16 +87,39 @@ void c_OutputCommon::ReportNewFrame ()
 {
     // DEBUG_START;
 
-    uint32_t Now = micros ();
+    uint32_t Now = OutputMgr.GetFrameClockInMicroSec ();
     FrameRefreshTimeInMicroSec = Now - FrameStartTimeInMicroSec;
     FrameStartTimeInMicroSec = Now;
 
+    // the first frame has no previous frame to measure the period against
+    Telemetry.StartFrame ((0 == FrameCount) ? 0 : FrameRefreshTimeInMicroSec, micros () - Now);
+
     FrameCount++;
 
     // DEBUG_END;
 
 } // ReportNewFrame
 
+//----------------------------------------------------------------------------
+///< Must only be called while the ISR is not reading from the frame buffer
+void c_OutputCommon::LatchFrameBuffer ()
+{
+    // DEBUG_START;
+
+    // keep the inputs out of the output buffer while it is copied
+    OutputMgr.LockBuffer ();
+
+    if (OutputMgr.IsFrameLatchPending (LastLatchedFrameId))
+    {
+        UpdateFrameBuffer ();
+    }
+
+    OutputMgr.UnlockBuffer ();
+
+    // DEBUG_END;
+
+} // LatchFrameBuffer
+
 //----------------------------------------------------------------------------
 bool c_OutputCommon::SetConfig (JsonObject & jsonConfig)
 {
@@ -22,6 +22,7 @@
 
 #include "../ESPixelStick.h"
 #include "OutputMgr.hpp"
+#include "OutputTelemetry.hpp"
 
 #ifdef ARDUINO_ARCH_ESP32
 #   include <driver/uart.h>
@@ -50,13 +51,20 @@ public:
             size_t       GetBufferUsedSize ()  { return OutputBufferSize;}     ///< Get the address of the buffer into which the E1.31 handler will stuff data
             OTYPE_t      GetOutputType ()      { return OutputType; }          ///< Have the instance report its type.
     virtual void         GetStatus (ArduinoJson::JsonObject & jsonStatus);
-            void         SetOutputBufferAddress (uint8_t* pNewOutputBuffer) { pOutputBuffer = pNewOutputBuffer; }
+            void         SetOutputBufferAddress (uint8_t* pNewOutputBuffer, uint8_t* pNewFrameBuffer) { pOutputBuffer = pNewOutputBuffer; pFrameBuffer = pNewFrameBuffer; pLatchSource = pNewOutputBuffer; }
+            void         SetLatchSourceAddress (uint8_t* pNewLatchSource) { pLatchSource = pNewLatchSource; } ///< Where UpdateFrameBuffer reads the latched frame from
+            uint8_t    * GetFrameBufferAddress () { return pFrameBuffer; }    ///< Get the address of the latched data the ISR sends from
     virtual void         SetOutputBufferSize (size_t NewOutputBufferSize)  { OutputBufferSize = NewOutputBufferSize; };
     virtual size_t       GetNumChannelsNeeded () = 0;
+            uint32_t     GetFrameMinDurationInMicroSec () { return FrameMinDurationInMicroSec; } ///< Shortest time between frame starts
+    virtual uint32_t     GetShortestFrameDurationInMicroSec () { return FrameMinDurationInMicroSec; } ///< Shortest frame the current config can produce
     virtual void         PauseOutput (bool State) {}
     virtual void         ClearBuffer ();
     virtual void         WriteChannelData (size_t StartChannelId, size_t ChannelCount, byte *pSourceData);
     virtual void         ReadChannelData (size_t StartChannelId, size_t ChannelCount, byte *pTargetData);
+    virtual void         MarkBufferDirty () {}                                 ///< The output buffer was changed without going through WriteChannelData
+    virtual void         LatchDirtyRange () {}                                 ///< LatchFrame took a copy of the output buffer
+            c_OutputTelemetry & GetTelemetry () { return Telemetry; }          ///< Frame timing and ISR load for this output
 
 protected:
 
@@ -67,18 +75,24 @@ protected:
     bool        HasBeenInitialized         = false;
     uint32_t    FrameMinDurationInMicroSec = 25000;
     uint8_t   * pOutputBuffer              = nullptr;
+    uint8_t   * pFrameBuffer               = nullptr;
+    uint8_t   * pLatchSource               = nullptr;  ///< The output buffer or the copy taken by LatchFrame
     size_t      OutputBufferSize           = 0;
     uint32_t    FrameCount                 = 0;
+    c_OutputTelemetry Telemetry;
 
     void ReportNewFrame ();
+    void LatchFrameBuffer ();
+    virtual void UpdateFrameBuffer () { memcpy (pFrameBuffer, pLatchSource, OutputBufferSize); }
 
     inline bool canRefresh ()
     {
-        return (micros () - FrameStartTimeInMicroSec) >= FrameMinDurationInMicroSec;
+        return (OutputMgr.GetFrameClockInMicroSec () - FrameStartTimeInMicroSec) >= FrameMinDurationInMicroSec;
     }
 
 private:
     uint32_t    FrameRefreshTimeInMicroSec = 0;
     uint32_t    FrameStartTimeInMicroSec   = 0;
+    uint32_t    LastLatchedFrameId         = 0;
 
 }; // c_OutputCommon
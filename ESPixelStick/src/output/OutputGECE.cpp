@@ -70,6 +70,16 @@ bool c_OutputGECE::SetConfig(ArduinoJson::JsonObject & jsonConfig)
     // DEBUG_START;
 
     c_OutputPixel::SetConfig(jsonConfig);
+
+    setFromJSON(ChangeOnly,    jsonConfig, CN_gecechange);
+    setFromJSON(FullRefreshMs, jsonConfig, CN_gecerefresh);
+
+    // start over with every bulb unknown so the next frame sends them all
+    InvalidateLastSentPackets();
+    pGECELastSent       = (ChangeOnly) ? LastSentPackets : nullptr;
+    pGECEPackets        = ChangedPackets;
+    GECEFullRefreshMs   = FullRefreshMs;
+    GECEPacketTimeInUs  = GECE_FRAME_TIME_USEC;
 #ifdef foo
     uint temp;
     temp = map(brightness, 0, 255, 0, 100);
@@ -93,6 +103,9 @@ void c_OutputGECE::GetConfig (ArduinoJson::JsonObject & jsonConfig)
 
     c_OutputPixel::GetConfig (jsonConfig);
 
+    jsonConfig[CN_gecechange]  = ChangeOnly;
+    jsonConfig[CN_gecerefresh] = FullRefreshMs;
+
     // DEBUG_END;
 } // GetConfig
 
@@ -100,8 +113,29 @@ void c_OutputGECE::GetConfig (ArduinoJson::JsonObject & jsonConfig)
 void c_OutputGECE::GetStatus (ArduinoJson::JsonObject & jsonStatus)
 {
     c_OutputPixel::GetStatus(jsonStatus);
+
+    if (ChangeOnly)
+    {
+        jsonStatus[F("GeceFullFrames")]    = GECEFullFrames;
+        jsonStatus[F("GecePartialFrames")] = GECEPartialFrames;
+        jsonStatus[F("GeceBulbsSkipped")]  = GECEBulbsSkipped;
+    }
 } // GetStatus
 
+//----------------------------------------------------------------------------
+void c_OutputGECE::InvalidateLastSentPackets ()
+{
+    // DEBUG_START;
+
+    // a GECE packet is only 26 bits so this never matches a real one
+    for (uint32_t & Packet : LastSentPackets)
+    {
+        Packet = uint32_t(-1);
+    }
+
+    // DEBUG_END;
+} // InvalidateLastSentPackets
+
 //----------------------------------------------------------------------------
 void c_OutputGECE::SetOutputBufferSize(uint16_t NumChannelsAvailable)
 {
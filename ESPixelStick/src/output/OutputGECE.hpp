@@ -74,6 +74,15 @@ private:
 
 #define GECE_FRAME_TIME_USEC                ((GECE_PACKET_SIZE * GECE_USEC_PER_GECE_BIT) + 90)
 #define GECE_FRAME_TIME_NSEC                (GECE_FRAME_TIME_USEC * NanoSecondsInAMicroSecond)
+#define GECE_DEFAULT_FULL_REFRESH_MS        1000
+
+    void InvalidateLastSentPackets ();
+
+    // change only mode. Only bulbs whose packet changed are sent
+    bool        ChangeOnly      = false;
+    uint32_t    FullRefreshMs   = GECE_DEFAULT_FULL_REFRESH_MS;
+    uint32_t    LastSentPackets[GECE_MAX_BULBS];
+    uint32_t    ChangedPackets[GECE_MAX_BULBS];
 
 };
 
@@ -45,6 +45,9 @@
 #define GECE_RED_MASK 0x0000000F
 #define GECE_RED_SHIFT 4
 
+// bulbs are addressed with 6 bits
+#define GECE_MAX_BULBS              ((GECE_ADDRESS_MASK >> GECE_ADDRESS_SHIFT) + 1)
+
 #define GECE_SET_ADDRESS(value)     ((uint32_t(value) << GECE_ADDRESS_SHIFT)   & GECE_ADDRESS_MASK)
 #define GECE_SET_BRIGHTNESS(value)  ((uint32_t(value) << GECE_INTENSITY_SHIFT) & GECE_INTENSITY_MASK)
 #define GECE_SET_BLUE(value)        ((uint32_t(value) << GECE_BLUE_SHIFT)      & GECE_BLUE_MASK)
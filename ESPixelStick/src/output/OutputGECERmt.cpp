@@ -136,6 +136,10 @@ void c_OutputGECERmt::Render ()
 
     Rmt.Render();
 
+    // BuildGECEChangeList sets the duration of the frame that just started
+    // from the number of bulbs it sends. The RMT paces the next frame start with its own copy
+    Rmt.SetMinFrameDurationInUs (FrameMinDurationInMicroSec);
+
     // DEBUG_END;
 
 } // Render
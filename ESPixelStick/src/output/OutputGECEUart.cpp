@@ -162,7 +162,6 @@ void c_OutputGECEUart::Render ()
         TimeLastFrameStartedMS = millis();
 #endif // def GECE_UART_DEBUG_COUNTERS
 
-        ReportNewFrame();
         Uart.StartNewFrame();
 
         // DEBUG_V();
@@ -143,10 +143,8 @@ void c_OutputGS8208Rmt::Render ()
 {
     // DEBUG_START;
 
-    if (Rmt.Render ())
-    {
-        ReportNewFrame ();
-    }
+    // the pixel data source reports the new frame
+    Rmt.Render ();
 
     // DEBUG_END;
 
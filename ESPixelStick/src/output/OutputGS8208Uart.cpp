@@ -164,7 +164,6 @@ void c_OutputGS8208Uart::Render()
 #endif // def GS8208_UART_DEBUG_COUNTERS
 
         Uart.StartNewFrame();
-        ReportNewFrame();
         
         // DEBUG_V();
 
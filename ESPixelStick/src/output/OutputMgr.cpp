@@ -27,6 +27,7 @@
 //-----------------------------------------------------------------------------
 // bring in driver definitions
 #include "OutputDisabled.hpp"
+#include "OutputRmt.hpp"
 #include "OutputAPA102Spi.hpp"
 #include "OutputGECEUart.hpp"
 #include "OutputGECERmt.hpp"
@@ -176,6 +177,43 @@ static const OutputChannelIdToGpioAndPortEntry_t OutputChannelIdToGpioAndPort[]
 
 };
 
+#ifdef OM_USE_RENDER_TASK
+//-----------------------------------------------------------------------------
+static void RenderTask (void * pvParameters)
+{
+    // DEBUG_START; // Need extra stack space to run this
+    c_OutputMgr * pOutputMgr = reinterpret_cast <c_OutputMgr*> (pvParameters);
+
+    // start the frame clock on a tick boundary
+    vTaskDelay (1);
+    TickType_t LastWakeTime = xTaskGetTickCount ();
+    pOutputMgr->StartFrameClock (LastWakeTime);
+
+    do
+    {
+        // the wake times are calculated from the previous wake time, not from now, so the clock does not drift
+        vTaskDelayUntil (&LastWakeTime, pOutputMgr->GetRenderPeriodInTicks ());
+        pOutputMgr->RenderTaskPoll (LastWakeTime);
+
+    } while (true);
+    // DEBUG_END;
+
+} // RenderTask
+
+//-----------------------------------------------------------------------------
+static uint32_t GreatestCommonDivisor (uint32_t a, uint32_t b)
+{
+    while (0 != b)
+    {
+        uint32_t Remainder = a % b;
+        a = b;
+        b = Remainder;
+    }
+    return a;
+
+} // GreatestCommonDivisor
+#endif // def OM_USE_RENDER_TASK
+
 //-----------------------------------------------------------------------------
 // Methods
 //-----------------------------------------------------------------------------
@@ -184,8 +222,7 @@ c_OutputMgr::c_OutputMgr ()
 {
     ConfigFileName = String (F ("/")) + String (CN_output_config) + F (".json");
 
-    // clear the input data buffer
-    memset ((char*)&OutputBuffer[0], 0, sizeof (OutputBuffer));
+    // the buffers get allocated once we know what the outputs need
 
 } // c_OutputMgr
 
@@ -195,12 +232,27 @@ c_OutputMgr::~c_OutputMgr()
 {
     // DEBUG_START;
 
+#ifdef OM_USE_RENDER_TASK
+    if (NULL != RenderTaskHandle)
+    {
+        // wait for the current render pass to finish
+        xSemaphoreTake (RenderMutex, portMAX_DELAY);
+        vTaskDelete (RenderTaskHandle);
+        RenderTaskHandle = NULL;
+    }
+#endif // def OM_USE_RENDER_TASK
+
     // delete pOutputInstances;
     for (DriverInfo_t & CurrentOutput : OutputChannelDrivers)
     {
         // the drivers will put the hardware in a safe state
         delete CurrentOutput.pOutputChannelDriver;
+        CurrentOutput.pOutputChannelDriver = nullptr;
     }
+
+    FreeBuffers ();
+    FreePatchTable ();
+
     // DEBUG_END;
 
 } // ~c_OutputMgr
@@ -231,6 +283,15 @@ void c_OutputMgr::Begin ()
 
         HasBeenInitialized = true;
 
+#ifdef ARDUINO_ARCH_ESP32
+        // recursive so that a caller that holds it can still use the public buffer functions
+        BufferMutex = xSemaphoreCreateRecursiveMutex ();
+        if (NULL == BufferMutex)
+        {
+            logcon (CN_stars + String (F (" Could not create the output buffer lock ")) + CN_stars);
+        }
+#endif // def ARDUINO_ARCH_ESP32
+
 #ifdef LED_FLASH_GPIO
         pinMode (LED_FLASH_GPIO, OUTPUT);
         digitalWrite (LED_FLASH_GPIO, LED_FLASH_OFF);
@@ -250,6 +311,17 @@ void c_OutputMgr::Begin ()
         // DEBUG_V();
         LoadConfig();
 
+#ifdef OM_USE_RENDER_TASK
+        RenderMutex = xSemaphoreCreateMutex ();
+        if ((NULL == RenderMutex) ||
+            (pdPASS != xTaskCreatePinnedToCore (RenderTask, "OutputRender", OM_RENDER_TASK_STACK_SIZE, this, OM_RENDER_TASK_PRIORITY, &RenderTaskHandle, OM_RENDER_TASK_CORE)))
+        {
+            // loop() will do the rendering
+            logcon (CN_stars + String (F (" Could not start the output render task ")) + CN_stars);
+            RenderTaskHandle = NULL;
+        }
+#endif // def OM_USE_RENDER_TASK
+
         // CreateNewConfig ();
     } while (false);
 
@@ -267,6 +339,23 @@ void c_OutputMgr::CreateJsonConfig (JsonObject& jsonConfig)
 
     // add OM config parameters
     // DEBUG_V ();
+#ifdef SUPPORT_RMT_OUTPUT
+    jsonConfig[CN_rmtstartmode] = uint32_t (RmtStartMode);
+    jsonConfig[CN_rmtmaxblocks] = RmtMaxMemBlocks;
+    jsonConfig[CN_rmtpreencode] = RmtPreEncode;
+#endif // def SUPPORT_RMT_OUTPUT
+
+    if (0 != NumPatchEntries)
+    {
+        JsonArray PatchArray = jsonConfig.createNestedArray (CN_patch);
+        for (size_t EntryIndex = 0; EntryIndex < NumPatchEntries; ++EntryIndex)
+        {
+            JsonObject PatchEntry = PatchArray.createNestedObject ();
+            PatchEntry[CN_in]    = PatchEntries[EntryIndex].InputStart;
+            PatchEntry[CN_out]   = PatchEntries[EntryIndex].OutputStart;
+            PatchEntry[CN_count] = PatchEntries[EntryIndex].Count;
+        }
+    }
     
     // add the channels header
     JsonObject OutputMgrChannelsData;
@@ -374,7 +463,7 @@ void c_OutputMgr::CreateNewConfig ()
     // DEBUG_V ();
 
     JsonConfig[CN_cfgver] = CurrentConfigVersion;
-    JsonConfig[F ("MaxChannels")] = sizeof(OutputBuffer);
+    JsonConfig[F ("MaxChannels")] = OM_MAX_NUM_CHANNELS;
 
     // DEBUG_V ("for each output type");
     for (auto CurrentOutputType : OutputTypeXlateMap)
@@ -453,6 +542,35 @@ void c_OutputMgr::GetStatus (JsonObject & jsonStatus)
 {
     // DEBUG_START;
 
+    JsonObject BufferStatus = jsonStatus.createNestedObject (F ("OutputBuffer"));
+    BufferStatus[F ("channels")]      = UsedBufferSize;
+    BufferStatus[F ("allocated")]     = AllocatedBufferSize;
+    // the frame buffer is always in internal memory
+    BufferStatus[F ("internalbytes")] = AllocatedBufferSize + ((OutputBufferIsInPsram) ? 0 : AllocatedBufferSize);
+    BufferStatus[F ("psrambytes")]    = (OutputBufferIsInPsram) ? AllocatedBufferSize : 0;
+    BufferStatus[F ("inputchannels")] = GetInputChannelCount ();
+    BufferStatus[F ("patchruns")]     = NumPatchRuns;
+
+#ifdef OM_USE_RENDER_TASK
+    JsonObject RenderStatus = jsonStatus.createNestedObject (F ("RenderTask"));
+    RenderStatus[F ("running")]     = (NULL != RenderTaskHandle);
+    RenderStatus[F ("periodus")]    = RenderPeriodInTicks * portTICK_PERIOD_MS * MicroSecondsInAmilliSecond;
+    RenderStatus[F ("jitteravgus")] = FrameStartJitterAvgInMicroSec;
+    RenderStatus[F ("jittermaxus")] = FrameStartJitterMaxInMicroSec;
+    FrameStartJitterMaxInMicroSec = 0;
+#endif // def OM_USE_RENDER_TASK
+
+#ifdef SUPPORT_RMT_OUTPUT
+    JsonObject RmtStartStatus = jsonStatus.createNestedObject (F ("RmtStart"));
+    RmtStartStatus[F ("mode")] = uint32_t (RmtStartMode);
+    c_OutputRmt::GetStartStatus (RmtStartStatus);
+
+    JsonObject RmtMemStatus = jsonStatus.createNestedObject (F ("RmtMemory"));
+    RmtMemStatus[F ("maxblocks")] = RmtMaxMemBlocks;
+    RmtMemStatus[F ("preencode")] = RmtPreEncode;
+    c_OutputRmt::GetMemStatus (RmtMemStatus);
+#endif // def SUPPORT_RMT_OUTPUT
+
     JsonArray OutputStatus = jsonStatus.createNestedArray (CN_output);
     for (auto & CurrentOutput : OutputChannelDrivers)
     {
@@ -1040,6 +1158,19 @@ bool c_OutputMgr::ProcessJsonConfig (JsonObject& jsonConfig)
             // break;
         }
 
+#ifdef SUPPORT_RMT_OUTPUT
+        uint32_t TempRmtStartMode = uint32_t (RmtStartMode);
+        setFromJSON (TempRmtStartMode, OutputChannelMgrData, CN_rmtstartmode);
+        RmtStartMode = (TempRmtStartMode < uint32_t (RmtStartMode_t::RmtStartModeEnd)) ? RmtStartMode_t (TempRmtStartMode) : RmtStartMode_t::RmtStartIndependent;
+
+        setFromJSON (RmtMaxMemBlocks, OutputChannelMgrData, CN_rmtmaxblocks);
+        RmtMaxMemBlocks = min (max (RmtMaxMemBlocks, uint8_t (1)), uint8_t (RMT_CHANNEL_MAX));
+        setFromJSON (RmtPreEncode, OutputChannelMgrData, CN_rmtpreencode);
+#endif // def SUPPORT_RMT_OUTPUT
+
+        // the patch table gets compiled once the output layout is known
+        LoadPatchTable (OutputChannelMgrData);
+
         // do we have a channel configuration array?
         if (false == OutputChannelMgrData.containsKey (CN_channels))
         {
@@ -1050,6 +1181,11 @@ bool c_OutputMgr::ProcessJsonConfig (JsonObject& jsonConfig)
         JsonObject OutputChannelArray = OutputChannelMgrData[CN_channels];
         // DEBUG_V ();
 
+#ifdef SUPPORT_RMT_OUTPUT
+        // the RMT memory has to be divided up before any of the RMT channels start
+        AllocateRmtMemBlocks (OutputChannelArray);
+#endif // def SUPPORT_RMT_OUTPUT
+
         // for each output channel
         for (auto & CurrentOutputChannelDriver : OutputChannelDrivers)
         {
@@ -1187,45 +1323,180 @@ void c_OutputMgr::SetConfig(ArduinoJson::JsonDocument & ConfigData)
 } // SaveConfig
 
 //-----------------------------------------------------------------------------
-///< Called from loop(), renders output data
+///< Called from loop(). Renders output data when there is no render task
 void c_OutputMgr::Render()
 {
     // DEBUG_START;
-    // do we need to save the current config?
+    // do we need to load a new config?
     if (true == ConfigLoadNeeded)
     {
         ConfigLoadNeeded = false;
-        LoadConfig ();
-    } // done need to save the current config
+
+#ifdef OM_USE_RENDER_TASK
+        // the render task must not use the drivers while they are being replaced
+        if (NULL != RenderTaskHandle)
+        {
+            xSemaphoreTake (RenderMutex, portMAX_DELAY);
+            LoadConfig ();
+            xSemaphoreGive (RenderMutex);
+        }
+        else
+#endif // def OM_USE_RENDER_TASK
+        {
+            LoadConfig ();
+        }
+    } // done need to load a new config
+
+#ifdef OM_USE_RENDER_TASK
+    if (NULL == RenderTaskHandle)
+#endif // def OM_USE_RENDER_TASK
+    {
+        FrameClockInMicroSec = micros ();
+        RenderOutputs ();
+    }
+
+    // DEBUG_END;
+} // render
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::RenderOutputs ()
+{
+    // DEBUG_START;
 
     if (false == IsOutputPaused)
     {
-        // DEBUG_START;
         for (DriverInfo_t & OutputChannel : OutputChannelDrivers)
         {
             OutputChannel.pOutputChannelDriver->Render ();
         }
+
+#ifdef SUPPORT_RMT_OUTPUT
+        c_OutputRmt::StartArmedChannels (RmtStartMode);
+#endif // def SUPPORT_RMT_OUTPUT
+    }
+
+    // DEBUG_END;
+} // RenderOutputs
+
+#ifdef OM_USE_RENDER_TASK
+//-----------------------------------------------------------------------------
+void c_OutputMgr::StartFrameClock (TickType_t StartTick)
+{
+    // DEBUG_START;
+
+    FrameClockStartTick       = StartTick;
+    FrameClockStartInMicroSec = micros ();
+    FrameClockInMicroSec      = FrameClockStartInMicroSec;
+
+    // DEBUG_END;
+} // StartFrameClock
+
+//-----------------------------------------------------------------------------
+/*
+    The frame clock is the time at which this pass was scheduled to run, not
+    the time it actually ran. The drivers use it to time their frames so a
+    late pass does not push all of the following frames back.
+*/
+void c_OutputMgr::RenderTaskPoll (TickType_t ScheduledTick)
+{
+    // DEBUG_START;
+
+    uint32_t Now = micros ();
+    uint32_t ScheduledTimeInMicroSec = FrameClockStartInMicroSec +
+        (uint32_t (ScheduledTick - FrameClockStartTick) * portTICK_PERIOD_MS * MicroSecondsInAmilliSecond);
+
+    int32_t Jitter = int32_t (Now - ScheduledTimeInMicroSec);
+    uint32_t JitterInMicroSec = (0 > Jitter) ? 0 : uint32_t (Jitter);
+    FrameStartJitterAvgInMicroSec = ((FrameStartJitterAvgInMicroSec * 15) + JitterInMicroSec) / 16;
+    FrameStartJitterMaxInMicroSec = max (FrameStartJitterMaxInMicroSec, JitterInMicroSec);
+
+    FrameClockInMicroSec = ScheduledTimeInMicroSec;
+
+    // skip this pass if loop() is replacing the drivers
+    if (pdTRUE == xSemaphoreTake (RenderMutex, 0))
+    {
+        RenderOutputs ();
+        xSemaphoreGive (RenderMutex);
+    }
+
+    // DEBUG_END;
+} // RenderTaskPoll
+
+//-----------------------------------------------------------------------------
+/*
+    Run the render task often enough that every output can start its frames
+    on time. Each output needs a whole number of ticks per frame, so the task
+    runs at the largest period that divides all of them. Outputs that shorten
+    their frames at run time (variable length DMX, change only GECE) report
+    the shortest frame they can send so the task can keep up with them.
+*/
+void c_OutputMgr::CalculateRenderPeriod ()
+{
+    // DEBUG_START;
+
+    uint32_t MicroSecondsPerTick = portTICK_PERIOD_MS * MicroSecondsInAmilliSecond;
+    uint32_t NewPeriodInTicks = 0;
+
+    for (auto & OutputChannel : OutputChannelDrivers)
+    {
+        if (e_OutputType::OutputType_Disabled == OutputChannel.pOutputChannelDriver->GetOutputType ())
+        {
+            continue;
+        }
+
+        uint32_t FramePeriodInTicks = (OutputChannel.pOutputChannelDriver->GetShortestFrameDurationInMicroSec () + MicroSecondsPerTick - 1) / MicroSecondsPerTick;
+        FramePeriodInTicks = max (uint32_t (1), FramePeriodInTicks);
+        NewPeriodInTicks = (0 == NewPeriodInTicks) ? FramePeriodInTicks : GreatestCommonDivisor (NewPeriodInTicks, FramePeriodInTicks);
+    }
+
+    if (0 == NewPeriodInTicks)
+    {
+        // nothing to send. Keep ticking over slowly
+        NewPeriodInTicks = max (TickType_t (1), pdMS_TO_TICKS (OM_DEFAULT_RENDER_PERIOD_MS));
     }
+
+    RenderPeriodInTicks = TickType_t (NewPeriodInTicks);
+    // DEBUG_V (String ("RenderPeriodInTicks: ") + String (RenderPeriodInTicks));
+
     // DEBUG_END;
-} // render
+} // CalculateRenderPeriod
+#endif // def OM_USE_RENDER_TASK
 
 //-----------------------------------------------------------------------------
 void c_OutputMgr::UpdateDisplayBufferReferences (void)
 {
     // DEBUG_START;
 
+    size_t TotalChannelsNeeded = 0;
+    for (auto & OutputChannel : OutputChannelDrivers)
+    {
+        TotalChannelsNeeded += OutputChannel.pOutputChannelDriver->GetNumChannelsNeeded ();
+    }
+    TotalChannelsNeeded = min (TotalChannelsNeeded, size_t (OM_MAX_NUM_CHANNELS));
+    // DEBUG_V (String ("TotalChannelsNeeded: ") + String (TotalChannelsNeeded));
+
+    // the inputs keep writing from their own task. Hold them off until the buffers and the patch runs agree again
+    LockBuffer ();
+
+    if (TotalChannelsNeeded != AllocatedBufferSize)
+    {
+        AllocateBuffers (TotalChannelsNeeded);
+    }
+
     size_t OutputBufferOffset = 0;
 
-    // DEBUG_V (String ("        BufferSize: ") + String (sizeof(OutputBuffer)));
+    // DEBUG_V (String ("        BufferSize: ") + String (AllocatedBufferSize));
     // DEBUG_V (String ("OutputBufferOffset: ") + String (OutputBufferOffset));
 
     for (auto & OutputChannel : OutputChannelDrivers)
     {
         OutputChannel.StartingChannelId = OutputBufferOffset;
-        OutputChannel.pOutputChannelDriver->SetOutputBufferAddress(&OutputBuffer[OutputBufferOffset]);
+        OutputChannel.pOutputChannelDriver->SetOutputBufferAddress(
+            (nullptr == OutputBuffer) ? nullptr : &OutputBuffer[OutputBufferOffset],
+            (nullptr == FrameBuffer)  ? nullptr : &FrameBuffer[OutputBufferOffset]);
 
         size_t ChannelsNeeded     = OutputChannel.pOutputChannelDriver->GetNumChannelsNeeded ();
-        size_t AvailableChannels  = sizeof(OutputBuffer) - OutputBufferOffset;
+        size_t AvailableChannels  = AllocatedBufferSize - OutputBufferOffset;
         size_t ChannelsToAllocate = min (ChannelsNeeded, AvailableChannels);
 
         // DEBUG_V (String ("    ChannelsNeeded: ") + String (ChannelsNeeded));
@@ -1249,16 +1520,239 @@ void c_OutputMgr::UpdateDisplayBufferReferences (void)
         // DEBUG_V (String ("OutputBufferOffset: ") + String(OutputBufferOffset));
     }
 
+    UpdateLatchSources ();
+
     // DEBUG_V (String ("   TotalBufferSize: ") + String (OutputBufferOffset));
     UsedBufferSize = OutputBufferOffset;
     // DEBUG_V (String ("       OutputBuffer: 0x") + String (uint32_t (OutputBuffer), HEX));
     // DEBUG_V (String ("     UsedBufferSize: ") + String (uint32_t (UsedBufferSize)));
-    InputMgr.SetBufferInfo (OutputBufferOffset);
+
+    // the patch runs depend on where each output landed in the buffer
+    CompilePatchTable ();
+
+    UnlockBuffer ();
+
+    // the inputs take their own locks. Do not hold ours while they reconfigure
+    InputMgr.SetBufferInfo (GetInputChannelCount ());
+
+#ifdef OM_USE_RENDER_TASK
+    // the frame times depend on the buffer sizes
+    CalculateRenderPeriod ();
+#endif // def OM_USE_RENDER_TASK
 
     // DEBUG_END;
 
 } // UpdateDisplayBufferReferences
 
+//-----------------------------------------------------------------------------
+/*
+    Replace the output buffers with a pair that holds NumChannels. If there is
+    not enough memory, keep trying with less until something fits. The
+    drivers get their new addresses from UpdateDisplayBufferReferences.
+
+    Called while holding the buffer lock so no input can write into the old
+    pair while it is replaced. The new pair is allocated before the old one
+    is released. Only when both do not fit is the old pair given up first.
+*/
+void c_OutputMgr::AllocateBuffers (size_t NumChannels)
+{
+    // DEBUG_START;
+
+    // the ISRs must not be reading from the old buffers while they are being replaced
+    bool WasPaused = IsOutputPaused;
+    PauseOutputs (true);
+
+    uint8_t * NewOutputBuffer        = nullptr;
+    uint8_t * NewFrameBuffer         = nullptr;
+    bool      NewOutputBufferInPsram = false;
+
+    while (NumChannels)
+    {
+#ifdef ARDUINO_ARCH_ESP32
+        NewFrameBuffer = (uint8_t*)heap_caps_malloc (NumChannels, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#else
+        NewFrameBuffer = (uint8_t*)malloc (NumChannels);
+#endif // def ARDUINO_ARCH_ESP32
+
+#ifdef BOARD_HAS_PSRAM
+        NewOutputBuffer = (uint8_t*)ps_malloc (NumChannels);
+        NewOutputBufferInPsram = (nullptr != NewOutputBuffer);
+        if (nullptr == NewOutputBuffer)
+#endif // def BOARD_HAS_PSRAM
+        {
+            NewOutputBuffer = (uint8_t*)malloc (NumChannels);
+        }
+
+        if ((nullptr != NewFrameBuffer) && (nullptr != NewOutputBuffer))
+        {
+            break;
+        }
+
+        free (NewFrameBuffer);
+        free (NewOutputBuffer);
+        NewFrameBuffer  = nullptr;
+        NewOutputBuffer = nullptr;
+
+        if (nullptr != OutputBuffer)
+        {
+            // make room by giving up the old pair and try again at the same size
+            DetachDrivers ();
+            FreeBuffers ();
+            continue;
+        }
+
+        logcon (String (F ("--- OutputMgr: ERROR: Not enough memory for ")) + String (NumChannels) + F (" channels. ---"));
+        NumChannels = NumChannels / 2;
+    }
+
+    // nothing may point at the old pair once it is gone
+    DetachDrivers ();
+    FreeBuffers ();
+
+    OutputBuffer          = NewOutputBuffer;
+    FrameBuffer           = NewFrameBuffer;
+    OutputBufferIsInPsram = NewOutputBufferInPsram;
+
+    if (NumChannels)
+    {
+        memset (OutputBuffer, 0x00, NumChannels);
+        memset (FrameBuffer,  0x00, NumChannels);
+    }
+    AllocatedBufferSize = NumChannels;
+
+    if (ExplicitLatch)
+    {
+        AllocateLatchedBuffer ();
+    }
+    // DEBUG_V (String ("AllocatedBufferSize: ") + String (AllocatedBufferSize));
+
+    PauseOutputs (WasPaused);
+
+    // DEBUG_END;
+
+} // AllocateBuffers
+
+//-----------------------------------------------------------------------------
+///< Take the buffers away from the drivers until UpdateDisplayBufferReferences hands out new ones
+void c_OutputMgr::DetachDrivers ()
+{
+    // DEBUG_START;
+
+    UsedBufferSize = 0;
+    for (auto & OutputChannel : OutputChannelDrivers)
+    {
+        OutputChannel.StartingChannelId = 0;
+        OutputChannel.ChannelCount      = 0;
+        OutputChannel.EndChannelId      = 0;
+        OutputChannel.pOutputChannelDriver->SetOutputBufferAddress (nullptr, nullptr);
+        OutputChannel.pOutputChannelDriver->SetOutputBufferSize (0);
+    }
+
+    // DEBUG_END;
+
+} // DetachDrivers
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::FreeBuffers ()
+{
+    // DEBUG_START;
+
+    if (nullptr != OutputBuffer)
+    {
+        free (OutputBuffer);
+        OutputBuffer = nullptr;
+    }
+
+    if (nullptr != FrameBuffer)
+    {
+        free (FrameBuffer);
+        FrameBuffer = nullptr;
+    }
+
+    OutputBufferIsInPsram = false;
+    AllocatedBufferSize   = 0;
+
+    FreeLatchedBuffer ();
+
+    // DEBUG_END;
+
+} // FreeBuffers
+
+//-----------------------------------------------------------------------------
+/*
+    While an input latches explicitly, LatchFrame copies the output buffer
+    here and the drivers latch from the copy. The inputs can then start on
+    the next frame without tearing the one the drivers have not picked up
+    yet. Without the copy the drivers fall back to the output buffer.
+*/
+void c_OutputMgr::AllocateLatchedBuffer ()
+{
+    // DEBUG_START;
+
+    FreeLatchedBuffer ();
+
+    do // once
+    {
+        if (0 == AllocatedBufferSize)
+        {
+            break;
+        }
+
+#ifdef BOARD_HAS_PSRAM
+        LatchedBuffer = (uint8_t*)ps_malloc (AllocatedBufferSize);
+        if (nullptr == LatchedBuffer)
+#endif // def BOARD_HAS_PSRAM
+        {
+            LatchedBuffer = (uint8_t*)malloc (AllocatedBufferSize);
+        }
+
+        if (nullptr == LatchedBuffer)
+        {
+            logcon (String (F ("--- OutputMgr: ERROR: Not enough memory to hold a latched frame. ---")));
+            break;
+        }
+
+        memset (LatchedBuffer, 0x00, AllocatedBufferSize);
+
+    } while (false);
+
+    // DEBUG_END;
+
+} // AllocateLatchedBuffer
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::FreeLatchedBuffer ()
+{
+    // DEBUG_START;
+
+    if (nullptr != LatchedBuffer)
+    {
+        free (LatchedBuffer);
+        LatchedBuffer = nullptr;
+    }
+
+    // DEBUG_END;
+
+} // FreeLatchedBuffer
+
+//-----------------------------------------------------------------------------
+///< Tell the drivers where to latch their frames from. Call while holding the buffer lock
+void c_OutputMgr::UpdateLatchSources ()
+{
+    // DEBUG_START;
+
+    uint8_t * pLatchSource = (nullptr != LatchedBuffer) ? LatchedBuffer : OutputBuffer;
+
+    for (auto & OutputChannel : OutputChannelDrivers)
+    {
+        OutputChannel.pOutputChannelDriver->SetLatchSourceAddress (
+            (nullptr == pLatchSource) ? nullptr : &pLatchSource[OutputChannel.StartingChannelId]);
+    }
+
+    // DEBUG_END;
+
+} // UpdateLatchSources
+
 //-----------------------------------------------------------------------------
 void c_OutputMgr::PauseOutputs(bool PauseTheOutput)
 {
@@ -1278,8 +1772,16 @@ void c_OutputMgr::WriteChannelData(size_t StartChannelId, size_t ChannelCount, b
 {
     // DEBUG_START;
 
+    LockBuffer ();
+
     do // once
     {
+        if (nullptr != PatchRuns)
+        {
+            WritePatchedChannelData (StartChannelId, ChannelCount, pSourceData);
+            break;
+        }
+
         if (((StartChannelId + ChannelCount) > UsedBufferSize) || (0 == ChannelCount))
         {
             // DEBUG_V (String("ERROR: Invalid parameters"));
@@ -1328,6 +1830,9 @@ void c_OutputMgr::WriteChannelData(size_t StartChannelId, size_t ChannelCount, b
         }
 
     } while (false);
+
+    UnlockBuffer ();
+
     // DEBUG_END;
 
 } // WriteChannelData
@@ -1337,8 +1842,16 @@ void c_OutputMgr::ReadChannelData(size_t StartChannelId, size_t ChannelCount, by
 {
     // DEBUG_START;
 
+    LockBuffer ();
+
     do // once
     {
+        if (nullptr != PatchRuns)
+        {
+            ReadPatchedChannelData (StartChannelId, ChannelCount, pTargetData);
+            break;
+        }
+
         if ((StartChannelId + ChannelCount) > UsedBufferSize)
         {
             // DEBUG_V (String("ERROR: Invalid parameters"));
@@ -1383,26 +1896,537 @@ void c_OutputMgr::ReadChannelData(size_t StartChannelId, size_t ChannelCount, by
         }
 
     } while (false);
+
+    UnlockBuffer ();
+
     // DEBUG_END;
 
 } // ReadChannelData
 
+#ifdef SUPPORT_RMT_OUTPUT
 //-----------------------------------------------------------------------------
-void c_OutputMgr::ClearBuffer()
+// Let the RMT channels that are not going to be used lend their memory to the ones that are
+void c_OutputMgr::AllocateRmtMemBlocks (JsonObject & OutputChannelArray)
 {
     // DEBUG_START;
 
-    for (auto & currentOutputChannelDriver : OutputChannelDrivers)
+    bool ChannelIsInUse[RMT_CHANNEL_MAX];
+    memset (ChannelIsInUse, 0x00, sizeof (ChannelIsInUse));
+
+    for (auto & CurrentOutputChannelDriver : OutputChannelDrivers)
     {
-        if(nullptr != currentOutputChannelDriver.pOutputChannelDriver)
+        // the RMT drivers use the output channel id as the RMT channel id
+        if (!OM_IS_RMT || (size_t (CurrentOutputChannelDriver.DriverId) >= size_t (RMT_CHANNEL_MAX)))
         {
-            currentOutputChannelDriver.pOutputChannelDriver->ClearBuffer();
+            continue;
+        }
+
+        uint32_t ChannelType = uint32_t (OutputType_Disabled);
+        String   ChannelId   = String (CurrentOutputChannelDriver.DriverId);
+        if (OutputChannelArray.containsKey (ChannelId.c_str ()))
+        {
+            JsonObject OutputChannelConfig = OutputChannelArray[ChannelId.c_str ()];
+            setFromJSON (ChannelType, OutputChannelConfig, CN_type);
         }
+
+        ChannelIsInUse[CurrentOutputChannelDriver.DriverId] = (uint32_t (OutputType_Disabled) != ChannelType) && (ChannelType < uint32_t (OutputType_End));
     }
 
-    // DEBUG_END;
+    c_OutputRmt::AllocateMemBlocks (ChannelIsInUse, RmtMaxMemBlocks);
+
+    // DEBUG_END;
+} // AllocateRmtMemBlocks
+#endif // def SUPPORT_RMT_OUTPUT
+
+//-----------------------------------------------------------------------------
+/*
+    Each entry in the patch table maps a range of input channels to a range
+    of output channels. Entries may overlap in the input space (duplication),
+    be in any order (reordering) and leave gaps (skipping).
+
+        "patch": [ {"in": 0, "out": 510, "count": 510}, ... ]
+*/
+void c_OutputMgr::LoadPatchTable (JsonObject & jsonConfig)
+{
+    // DEBUG_START;
+
+    FreePatchTable ();
+
+    do // once
+    {
+        if (false == jsonConfig.containsKey (CN_patch))
+        {
+            // no patching. Inputs map straight through to the outputs
+            break;
+        }
+
+        JsonArray PatchArray = jsonConfig[CN_patch];
+        size_t NumEntriesToLoad = min (PatchArray.size (), size_t (OM_MAX_PATCH_ENTRIES));
+        if (PatchArray.size () > NumEntriesToLoad)
+        {
+            logcon (String (F ("--- OutputMgr: ERROR: Too many patch entries. Using the first ")) + String (NumEntriesToLoad));
+        }
+
+        if (0 == NumEntriesToLoad)
+        {
+            break;
+        }
+
+        PatchEntries = (PatchEntry_t *)malloc (NumEntriesToLoad * sizeof (PatchEntry_t));
+        if (nullptr == PatchEntries)
+        {
+            logcon (String (F ("--- OutputMgr: ERROR: Could not allocate the patch table")));
+            break;
+        }
+
+        for (JsonObject PatchConfig : PatchArray)
+        {
+            if (NumPatchEntries >= NumEntriesToLoad)
+            {
+                break;
+            }
+
+            PatchEntry_t & NewEntry = PatchEntries[NumPatchEntries];
+            NewEntry.InputStart  = 0;
+            NewEntry.OutputStart = 0;
+            NewEntry.Count       = 0;
+            setFromJSON (NewEntry.InputStart,  PatchConfig, CN_in);
+            setFromJSON (NewEntry.OutputStart, PatchConfig, CN_out);
+            setFromJSON (NewEntry.Count,       PatchConfig, CN_count);
+
+            if (NewEntry.InputStart >= OM_MAX_NUM_CHANNELS)
+            {
+                logcon (String (F ("--- OutputMgr: ERROR: Patch input channel is out of range: ")) + String (NewEntry.InputStart));
+                continue;
+            }
+            NewEntry.Count = min (NewEntry.Count, size_t (OM_MAX_NUM_CHANNELS) - NewEntry.InputStart);
+
+            if (0 != NewEntry.Count)
+            {
+                ++NumPatchEntries;
+            }
+        }
+
+    } while (false);
+
+    // DEBUG_V (String ("NumPatchEntries: ") + String (NumPatchEntries));
+
+    // DEBUG_END;
+} // LoadPatchTable
+
+//-----------------------------------------------------------------------------
+/*
+    Turn the patch entries into a list of runs sorted by input channel where
+    every run lands inside one driver. WriteChannelData can then hand each
+    run straight to its driver as one copy.
+*/
+void c_OutputMgr::CompilePatchTable ()
+{
+    // DEBUG_START;
+
+    // fall back to the straight mapping while the runs are rebuilt
+    PatchRun_t * OldPatchRuns = PatchRuns;
+    PatchRuns              = nullptr;
+    NumPatchRuns           = 0;
+    MaxPatchRunCount       = 0;
+    PatchInputChannelCount = 0;
+    free (OldPatchRuns);
+
+    do // once
+    {
+        if (0 == NumPatchEntries)
+        {
+            break;
+        }
+
+        // worst case is every entry being split at every driver boundary
+        size_t MaxRuns = NumPatchEntries * size_t (OutputChannelId_End);
+        PatchRun_t * NewPatchRuns = (PatchRun_t *)malloc (MaxRuns * sizeof (PatchRun_t));
+        if (nullptr == NewPatchRuns)
+        {
+            logcon (String (F ("--- OutputMgr: ERROR: Could not allocate the patch runs. Patching is disabled")));
+            break;
+        }
+
+        size_t NewNumPatchRuns = 0;
+        size_t NewInputChannelCount = 0;
+
+        for (size_t EntryIndex = 0; EntryIndex < NumPatchEntries; ++EntryIndex)
+        {
+            PatchEntry_t & CurrentEntry = PatchEntries[EntryIndex];
+            NewInputChannelCount = max (NewInputChannelCount, CurrentEntry.InputStart + CurrentEntry.Count);
+
+            size_t InputChannelId    = CurrentEntry.InputStart;
+            size_t OutputChannelId   = CurrentEntry.OutputStart;
+            size_t ChannelsRemaining = CurrentEntry.Count;
+
+            for (size_t DriverIndex = 0; (DriverIndex < size_t (OutputChannelId_End)) && (0 != ChannelsRemaining); ++DriverIndex)
+            {
+                DriverInfo_t & CurrentDriver = OutputChannelDrivers[DriverIndex];
+                if ((OutputChannelId < CurrentDriver.StartingChannelId) || (OutputChannelId >= CurrentDriver.EndChannelId))
+                {
+                    continue;
+                }
+
+                size_t ChannelsInThisDriver = min (ChannelsRemaining, CurrentDriver.EndChannelId - OutputChannelId);
+
+                PatchRun_t & NewRun = NewPatchRuns[NewNumPatchRuns++];
+                NewRun.InputStart  = InputChannelId;
+                NewRun.Count       = ChannelsInThisDriver;
+                NewRun.DriverIndex = DriverIndex;
+                NewRun.DriverStart = OutputChannelId - CurrentDriver.StartingChannelId;
+
+                InputChannelId    += ChannelsInThisDriver;
+                OutputChannelId   += ChannelsInThisDriver;
+                ChannelsRemaining -= ChannelsInThisDriver;
+            }
+            // anything left over is past the end of the configured outputs and is dropped
+        }
+
+        // sort by input channel. The table is small and this only runs on a config change
+        for (size_t RunIndex = 1; RunIndex < NewNumPatchRuns; ++RunIndex)
+        {
+            PatchRun_t RunToInsert = NewPatchRuns[RunIndex];
+            size_t InsertIndex = RunIndex;
+            while ((0 != InsertIndex) && (NewPatchRuns[InsertIndex - 1].InputStart > RunToInsert.InputStart))
+            {
+                NewPatchRuns[InsertIndex] = NewPatchRuns[InsertIndex - 1];
+                --InsertIndex;
+            }
+            NewPatchRuns[InsertIndex] = RunToInsert;
+        }
+
+        // merge runs that continue each other in both the input and the driver
+        size_t NumMergedRuns = 0;
+        for (size_t RunIndex = 0; RunIndex < NewNumPatchRuns; ++RunIndex)
+        {
+            PatchRun_t & CurrentRun = NewPatchRuns[RunIndex];
+            if (0 != NumMergedRuns)
+            {
+                PatchRun_t & PreviousRun = NewPatchRuns[NumMergedRuns - 1];
+                if ((PreviousRun.DriverIndex == CurrentRun.DriverIndex) &&
+                    ((PreviousRun.InputStart  + PreviousRun.Count) == CurrentRun.InputStart) &&
+                    ((PreviousRun.DriverStart + PreviousRun.Count) == CurrentRun.DriverStart))
+                {
+                    PreviousRun.Count += CurrentRun.Count;
+                    continue;
+                }
+            }
+            NewPatchRuns[NumMergedRuns++] = CurrentRun;
+        }
+
+        for (size_t RunIndex = 0; RunIndex < NumMergedRuns; ++RunIndex)
+        {
+            MaxPatchRunCount = max (MaxPatchRunCount, NewPatchRuns[RunIndex].Count);
+        }
+
+        NumPatchRuns           = NumMergedRuns;
+        PatchInputChannelCount = NewInputChannelCount;
+        PatchRuns              = NewPatchRuns;
+
+        // DEBUG_V (String ("          NumPatchRuns: ") + String (NumPatchRuns));
+        // DEBUG_V (String ("PatchInputChannelCount: ") + String (PatchInputChannelCount));
+
+    } while (false);
+
+    // DEBUG_END;
+} // CompilePatchTable
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::FreePatchTable ()
+{
+    // DEBUG_START;
+
+    // WriteChannelData walks the runs from the input task
+    LockBuffer ();
+
+    free (PatchRuns);
+    PatchRuns        = nullptr;
+    NumPatchRuns     = 0;
+    MaxPatchRunCount = 0;
+
+    free (PatchEntries);
+    PatchEntries    = nullptr;
+    NumPatchEntries = 0;
+
+    UnlockBuffer ();
+
+    // DEBUG_END;
+} // FreePatchTable
+
+//-----------------------------------------------------------------------------
+// Index of the first run that could include StartChannelId
+size_t c_OutputMgr::FindFirstPatchRun (size_t StartChannelId)
+{
+    // a run that starts before this cannot reach StartChannelId
+    size_t EarliestInputStart = (StartChannelId >= MaxPatchRunCount) ? (StartChannelId - MaxPatchRunCount + 1) : 0;
+
+    size_t LowIndex  = 0;
+    size_t HighIndex = NumPatchRuns;
+    while (LowIndex < HighIndex)
+    {
+        size_t MidIndex = (LowIndex + HighIndex) / 2;
+        if (PatchRuns[MidIndex].InputStart < EarliestInputStart)
+        {
+            LowIndex = MidIndex + 1;
+        }
+        else
+        {
+            HighIndex = MidIndex;
+        }
+    }
+
+    return LowIndex;
+
+} // FindFirstPatchRun
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::WritePatchedChannelData (size_t StartChannelId, size_t ChannelCount, byte *pSourceData)
+{
+    // DEBUG_START;
+
+    do // once
+    {
+        if (((StartChannelId + ChannelCount) > PatchInputChannelCount) || (0 == ChannelCount))
+        {
+            // DEBUG_V (String("ERROR: Invalid parameters"));
+            break;
+        }
+
+        size_t EndChannelId = StartChannelId + ChannelCount;
+        for (size_t RunIndex = FindFirstPatchRun (StartChannelId); RunIndex < NumPatchRuns; ++RunIndex)
+        {
+            PatchRun_t & CurrentRun = PatchRuns[RunIndex];
+            if (CurrentRun.InputStart >= EndChannelId)
+            {
+                // the rest of the runs start after this data
+                break;
+            }
+
+            size_t RunEndChannelId = CurrentRun.InputStart + CurrentRun.Count;
+            if (RunEndChannelId <= StartChannelId)
+            {
+                continue;
+            }
+
+            size_t FirstChannelId = max (StartChannelId, CurrentRun.InputStart);
+            size_t LastChannelId  = min (EndChannelId, RunEndChannelId);
+
+            OutputChannelDrivers[CurrentRun.DriverIndex].pOutputChannelDriver->WriteChannelData (
+                CurrentRun.DriverStart + (FirstChannelId - CurrentRun.InputStart),
+                LastChannelId - FirstChannelId,
+                &pSourceData[FirstChannelId - StartChannelId]);
+        }
+
+    } while (false);
+
+    // DEBUG_END;
+} // WritePatchedChannelData
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::ReadPatchedChannelData (size_t StartChannelId, size_t ChannelCount, byte *pTargetData)
+{
+    // DEBUG_START;
+
+    do // once
+    {
+        if ((StartChannelId + ChannelCount) > PatchInputChannelCount)
+        {
+            // DEBUG_V (String("ERROR: Invalid parameters"));
+            break;
+        }
+
+        // input channels that are not patched read back as zero
+        memset (pTargetData, 0x00, ChannelCount);
+
+        size_t EndChannelId = StartChannelId + ChannelCount;
+        for (size_t RunIndex = FindFirstPatchRun (StartChannelId); RunIndex < NumPatchRuns; ++RunIndex)
+        {
+            PatchRun_t & CurrentRun = PatchRuns[RunIndex];
+            if (CurrentRun.InputStart >= EndChannelId)
+            {
+                break;
+            }
+
+            size_t RunEndChannelId = CurrentRun.InputStart + CurrentRun.Count;
+            if (RunEndChannelId <= StartChannelId)
+            {
+                continue;
+            }
+
+            size_t FirstChannelId = max (StartChannelId, CurrentRun.InputStart);
+            size_t LastChannelId  = min (EndChannelId, RunEndChannelId);
+
+            OutputChannelDrivers[CurrentRun.DriverIndex].pOutputChannelDriver->ReadChannelData (
+                CurrentRun.DriverStart + (FirstChannelId - CurrentRun.InputStart),
+                LastChannelId - FirstChannelId,
+                &pTargetData[FirstChannelId - StartChannelId]);
+        }
+
+    } while (false);
+
+    // DEBUG_END;
+} // ReadPatchedChannelData
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::ClearBuffer()
+{
+    // DEBUG_START;
+
+    LockBuffer ();
+
+    for (auto & currentOutputChannelDriver : OutputChannelDrivers)
+    {
+        if(nullptr != currentOutputChannelDriver.pOutputChannelDriver)
+        {
+            currentOutputChannelDriver.pOutputChannelDriver->ClearBuffer();
+        }
+    }
+
+    // make sure the cleared data gets sent even if an input is holding the latch
+    LatchFrame ();
+
+    UnlockBuffer ();
+
+    // DEBUG_END;
 
 } // ClearBuffer
 
+//-----------------------------------------------------------------------------
+void c_OutputMgr::MarkBufferDirty()
+{
+    // DEBUG_START;
+
+    LockBuffer ();
+
+    for (auto & currentOutputChannelDriver : OutputChannelDrivers)
+    {
+        if(nullptr != currentOutputChannelDriver.pOutputChannelDriver)
+        {
+            currentOutputChannelDriver.pOutputChannelDriver->MarkBufferDirty();
+        }
+    }
+
+    UnlockBuffer ();
+
+    // DEBUG_END;
+
+} // MarkBufferDirty
+
+//-----------------------------------------------------------------------------
+/*
+    On the ESP32 the inputs write from the network task while the render task
+    latches the frames, so everything that touches the output buffer or the
+    drivers' dirty ranges does it while holding this lock. Nothing else may be
+    locked while it is held. On the ESP8266 the network callbacks and the
+    render pass both run from loop() and there is nothing to do.
+*/
+void c_OutputMgr::LockBuffer ()
+{
+#ifdef ARDUINO_ARCH_ESP32
+    if (NULL != BufferMutex)
+    {
+        xSemaphoreTakeRecursive (BufferMutex, portMAX_DELAY);
+    }
+#endif // def ARDUINO_ARCH_ESP32
+
+} // LockBuffer
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::UnlockBuffer ()
+{
+#ifdef ARDUINO_ARCH_ESP32
+    if (NULL != BufferMutex)
+    {
+        xSemaphoreGiveRecursive (BufferMutex);
+    }
+#endif // def ARDUINO_ARCH_ESP32
+
+} // UnlockBuffer
+
+//-----------------------------------------------------------------------------
+/*
+    The inputs write into OutputBuffer while the output ISRs stream from
+    FrameBuffer. Each driver copies its section of OutputBuffer into
+    FrameBuffer at the start of a frame (while its ISR is idle) so a frame
+    is never sent with a mix of old and new data.
+
+    By default every frame start latches whatever is in the buffer. An input
+    that knows where its frame boundaries are (sync packets etc) can set
+    ExplicitLatch and call LatchFrame() when a complete frame is available.
+    LatchFrame then copies the whole buffer while holding the buffer lock so
+    every driver sends the same frame, no matter how long it takes a driver
+    to get to its next frame start.
+*/
+void c_OutputMgr::LatchFrame ()
+{
+    // DEBUG_START;
+
+    LockBuffer ();
+
+    if (nullptr != LatchedBuffer)
+    {
+        memcpy (LatchedBuffer, OutputBuffer, UsedBufferSize);
+
+        for (auto & currentOutputChannelDriver : OutputChannelDrivers)
+        {
+            currentOutputChannelDriver.pOutputChannelDriver->LatchDirtyRange ();
+        }
+    }
+
+    ++LatchedFrameId;
+
+    UnlockBuffer ();
+
+    // DEBUG_END;
+
+} // LatchFrame
+
+//-----------------------------------------------------------------------------
+void c_OutputMgr::SetExplicitLatch (bool value)
+{
+    // DEBUG_START;
+
+    LockBuffer ();
+
+    if (ExplicitLatch != value)
+    {
+        ExplicitLatch = value;
+
+        if (ExplicitLatch)
+        {
+            AllocateLatchedBuffer ();
+        }
+        else
+        {
+            FreeLatchedBuffer ();
+        }
+        UpdateLatchSources ();
+
+        // send what we have so far when switching modes
+        LatchFrame ();
+    }
+
+    UnlockBuffer ();
+
+    // DEBUG_END;
+
+} // SetExplicitLatch
+
+//-----------------------------------------------------------------------------
+bool c_OutputMgr::IsFrameLatchPending (uint32_t & LastLatchedFrameId)
+{
+    // DEBUG_START;
+
+    uint32_t CurrentLatchedFrameId = LatchedFrameId;
+    bool Response = (false == ExplicitLatch) || (LastLatchedFrameId != CurrentLatchedFrameId);
+    LastLatchedFrameId = CurrentLatchedFrameId;
+
+    // DEBUG_END;
+
+    return Response;
+
+} // IsFrameLatchPending
+
 // create a global instance of the output channel factory
 c_OutputMgr OutputMgr;
@@ -29,6 +29,21 @@
 
 class c_OutputCommon; ///< forward declaration to the pure virtual output class that will be defined later.
 
+#if defined(ARDUINO_ARCH_ESP32)
+#   include <esp_task.h>
+#   include <freertos/semphr.h>
+
+// Render the outputs from a dedicated task so that frame starts do not wait on loop()
+#   define OM_USE_RENDER_TASK
+#   ifndef ARDUINO_RUNNING_CORE
+#       define ARDUINO_RUNNING_CORE 1
+#   endif // ndef ARDUINO_RUNNING_CORE
+#   define OM_RENDER_TASK_STACK_SIZE    4096
+#   define OM_RENDER_TASK_PRIORITY      (ESP_TASK_PRIO_MIN + 5)
+#   define OM_RENDER_TASK_CORE          ARDUINO_RUNNING_CORE
+#   define OM_DEFAULT_RENDER_PERIOD_MS  25
+#endif // defined(ARDUINO_ARCH_ESP32)
+
 #ifdef UART_LAST
 #       define NUM_UARTS UART_LAST
 #else
@@ -42,7 +57,7 @@ public:
     virtual ~c_OutputMgr ();
 
     void      Begin             ();                        ///< set up the operating environment based on the current config (or defaults)
-    void      Render            ();                        ///< Call from loop(),  renders output data
+    void      Render            ();                        ///< Call from loop(). Handles config changes and renders output data when there is no render task
     void      LoadConfig        ();                        ///< Read the current configuration data from nvram
     void      GetConfig         (byte * Response, size_t maxlen);
     void      GetConfig         (String & Response);
@@ -52,13 +67,42 @@ public:
     void      GetPortCounts     (uint16_t& PixelCount, uint16_t& SerialCount) {PixelCount = uint16_t(OutputChannelId_End); SerialCount = uint16_t(NUM_UARTS); }
     uint8_t*  GetBufferAddress  () { return OutputBuffer; } ///< Get the address of the buffer into which the E1.31 handler will stuff data
     size_t    GetBufferUsedSize () { return UsedBufferSize; } ///< Get the size (in intensities) of the buffer into which the E1.31 handler will stuff data
-    size_t    GetBufferSize     () { return sizeof(OutputBuffer); } ///< Get the size (in intensities) of the buffer into which the E1.31 handler will stuff data
+    size_t    GetBufferSize     () { return AllocatedBufferSize; } ///< Get the size (in intensities) of the buffer into which the E1.31 handler will stuff data
+    size_t    GetInputChannelCount () { return (nullptr == PatchRuns) ? UsedBufferSize : PatchInputChannelCount; } ///< Number of channels the inputs can write to
+    bool      IsPatched         () { return (nullptr != PatchRuns); } ///< true = input channels are mapped to the outputs by the patch table
+    uint8_t*  GetFrameBufferAddress () { return FrameBuffer; } ///< Get the address of the latched frame that the output ISRs stream from
+    void      LatchFrame        ();                        ///< Commit the current contents of the output buffer as the next frame to send
+    void      SetExplicitLatch  (bool value);              ///< true = frames are only committed via LatchFrame(). false = every frame start latches
+    bool      IsFrameLatchPending (uint32_t & LastLatchedFrameId); ///< Called by a driver at frame start to decide if it needs to latch new data
     void      DeleteConfig      () { FileMgr.DeleteConfigFile (ConfigFileName); }
     void      PauseOutputs      (bool NewState);
     void      GetDriverName     (String & Name) { Name = "OutputMgr"; }
     void      WriteChannelData  (size_t StartChannelId, size_t ChannelCount, byte * pData);
     void      ReadChannelData   (size_t StartChannelId, size_t ChannelCount, byte *pTargetData);
     void      ClearBuffer       ();
+    void      MarkBufferDirty   ();                        ///< Call after writing to the buffer directly (not using WriteChannelData)
+    void      LockBuffer        ();                        ///< Held while the output buffer is written, latched or replaced
+    void      UnlockBuffer      ();
+    uint32_t  GetFrameClockInMicroSec () { return FrameClockInMicroSec; } ///< Time of the current render pass. Drivers pace their frames with it
+
+#ifdef SUPPORT_RMT_OUTPUT
+    // how the RMT channels that are ready in the same render pass get started
+    enum RmtStartMode_t
+    {
+        RmtStartIndependent = 0,    ///< each channel starts as soon as it is ready
+        RmtStartSimultaneous,       ///< all ready channels start together
+        RmtStartStaggered,          ///< ready channels start spread over one RMT interrupt interval
+        RmtStartModeEnd,
+    };
+    RmtStartMode_t GetRmtStartMode () { return RmtStartMode; }
+    bool           GetRmtPreEncode () { return RmtPreEncode; }  ///< Encode whole frames into RAM before sending them
+#endif // def SUPPORT_RMT_OUTPUT
+
+#ifdef OM_USE_RENDER_TASK
+    void       StartFrameClock        (TickType_t StartTick);      ///< Called by the render task before its first pass
+    void       RenderTaskPoll         (TickType_t ScheduledTick);  ///< Called by the render task once per render period
+    TickType_t GetRenderPeriodInTicks () { return RenderPeriodInTicks; }
+#endif // def OM_USE_RENDER_TASK
 
     // handles to determine which output channel we are dealing with
     enum e_OutputChannelIds
@@ -169,15 +213,19 @@ public:
 #   define OM_MAX_NUM_CHANNELS      (1200 * 3)
 #   define OM_MAX_CONFIG_SIZE       ((size_t)(5 * 1024))
 #else // ARDUINO_ARCH_ESP32
+// The buffers are allocated to fit the configured outputs.
+// These are just upper limits. Available memory is the real limit.
 #   ifdef BOARD_HAS_PSRAM
-#       define OM_MAX_NUM_CHANNELS  (7000 * 3)
+#       define OM_MAX_NUM_CHANNELS  (16000 * 3)
 #       define OM_MAX_CONFIG_SIZE   ((size_t)(20 * 1024))
 #   else
-#       define OM_MAX_NUM_CHANNELS  (3000 * 3)
+#       define OM_MAX_NUM_CHANNELS  (8000 * 3)
 #       define OM_MAX_CONFIG_SIZE   ((size_t)(11 * 1024))
 #   endif // !def BOARD_HAS_PSRAM
 #endif // !def ARDUINO_ARCH_ESP32
 
+#define OM_MAX_PATCH_ENTRIES    128
+
 private:
         // pointer(s) to the current active output drivers
         struct DriverInfo_t
@@ -203,11 +251,76 @@ private:
     void UpdateDisplayBufferReferences (void);
     void InstantiateNewOutputChannel(DriverInfo_t &ChannelIndex, e_OutputType NewChannelType, bool StartDriver = true);
     void CreateNewConfig();
+    void AllocateBuffers (size_t NumChannels);
+    void FreeBuffers ();
+    void DetachDrivers ();
+    void AllocateLatchedBuffer ();
+    void FreeLatchedBuffer ();
+    void UpdateLatchSources ();
+    void RenderOutputs ();
+    void LoadPatchTable (JsonObject & jsonConfig);
+    void CompilePatchTable ();
+    void FreePatchTable ();
+    size_t FindFirstPatchRun (size_t StartChannelId);
+    void WritePatchedChannelData (size_t StartChannelId, size_t ChannelCount, byte * pSourceData);
+    void ReadPatchedChannelData  (size_t StartChannelId, size_t ChannelCount, byte * pTargetData);
 
     String ConfigFileName;
 
-    uint8_t OutputBuffer[OM_MAX_NUM_CHANNELS];
-    size_t  UsedBufferSize = 0;
+    uint8_t * OutputBuffer          = nullptr;  ///< Inputs write here. Uses PSRAM when available
+    uint8_t * FrameBuffer           = nullptr;  ///< Output drivers send from here. Always internal RAM so the ISRs can use it
+    uint8_t * LatchedBuffer         = nullptr;  ///< Copy of OutputBuffer taken by LatchFrame. Only allocated while ExplicitLatch is set
+    bool      OutputBufferIsInPsram = false;
+    size_t    AllocatedBufferSize   = 0;
+    size_t    UsedBufferSize = 0;
+    bool    ExplicitLatch  = false;
+    volatile uint32_t LatchedFrameId = 0;
+    uint32_t  FrameClockInMicroSec  = 0;
+#ifdef ARDUINO_ARCH_ESP32
+    SemaphoreHandle_t BufferMutex   = NULL;     ///< The inputs write from the network task while the drivers latch from the render task
+#endif // def ARDUINO_ARCH_ESP32
+
+    // Optional mapping of input channels to output channels
+    struct PatchEntry_t
+    {
+        size_t InputStart;
+        size_t OutputStart;
+        size_t Count;
+    };
+    PatchEntry_t * PatchEntries     = nullptr;  ///< As configured
+    size_t    NumPatchEntries       = 0;
+
+    // The patch entries broken up into runs that are contiguous in the input
+    // space and land in a single driver. Sorted by InputStart.
+    struct PatchRun_t
+    {
+        size_t InputStart;
+        size_t Count;
+        size_t DriverIndex;
+        size_t DriverStart;     ///< First channel relative to the start of the driver
+    };
+    PatchRun_t * PatchRuns          = nullptr;
+    size_t    NumPatchRuns          = 0;
+    size_t    MaxPatchRunCount      = 0;
+    size_t    PatchInputChannelCount = 0;
+#ifdef SUPPORT_RMT_OUTPUT
+    RmtStartMode_t RmtStartMode     = RmtStartMode_t::RmtStartIndependent;
+    uint8_t   RmtMaxMemBlocks       = 1;        ///< Most 64 slot memory blocks one RMT channel may borrow
+    bool      RmtPreEncode          = false;
+    void      AllocateRmtMemBlocks (JsonObject & OutputChannelArray);
+#endif // def SUPPORT_RMT_OUTPUT
+
+#ifdef OM_USE_RENDER_TASK
+    void CalculateRenderPeriod ();
+
+    TaskHandle_t      RenderTaskHandle              = NULL;
+    SemaphoreHandle_t RenderMutex                   = NULL; ///< Held by the render task while it uses the drivers
+    TickType_t        RenderPeriodInTicks           = 1;
+    TickType_t        FrameClockStartTick           = 0;
+    uint32_t          FrameClockStartInMicroSec     = 0;
+    uint32_t          FrameStartJitterAvgInMicroSec = 0;    ///< Running average of how late the render passes start
+    uint32_t          FrameStartJitterMaxInMicroSec = 0;    ///< Worst case since the last status request
+#endif // def OM_USE_RENDER_TASK
 
 #ifdef SUPPORT_UART_OUTPUT
 #       define OM_IS_UART ((CurrentOutputChannelDriver.DriverId >= OutputChannelId_UART_FIRST) && (CurrentOutputChannelDriver.DriverId <= OutputChannelId_UART_LAST))
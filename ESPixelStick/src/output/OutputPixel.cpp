@@ -21,7 +21,13 @@
 #include "OutputPixel.hpp"
 #include "OutputGECEFrame.hpp"
 
-#define ADJUST_INTENSITY_AT_ISR
+// ESP32: gamma, brightness, color order and zig zag are applied in the main
+// loop when a frame is latched (UpdateFrameBuffer) and the ISR just copies
+// bytes. The ESP8266 has more ISR time than main loop time to spare so it
+// keeps making the adjustments in the ISR.
+#ifdef ARDUINO_ARCH_ESP8266
+#   define ADJUST_INTENSITY_AT_ISR
+#endif // def ARDUINO_ARCH_ESP8266
 
 //----------------------------------------------------------------------------
 c_OutputPixel::c_OutputPixel (c_OutputMgr::e_OutputChannelIds OutputChannelId,
@@ -34,6 +40,7 @@ c_OutputPixel::c_OutputPixel (c_OutputMgr::e_OutputChannelIds OutputChannelId,
 
     updateGammaTable ();
     updateColorOrderOffsets ();
+    SelectPixelEncoders ();
 
     // DEBUG_END;
 } // c_OutputPixel
@@ -60,6 +67,8 @@ void c_OutputPixel::GetConfig (ArduinoJson::JsonObject& jsonConfig)
     jsonConfig[CN_interframetime] = InterFrameGapInMicroSec;
     jsonConfig[CN_prependnullcount] = PrependNullPixelCount;
     jsonConfig[CN_appendnullcount] = AppendNullPixelCount;
+    jsonConfig[CN_hfr] = HighFrameRate;
+    jsonConfig[CN_maxfps] = MaxFrameRate;
 
     c_OutputCommon::GetConfig (jsonConfig);
 
@@ -110,6 +119,9 @@ void c_OutputPixel::SetOutputBufferSize(size_t NumChannelsAvailable)
     // DEBUG_V (String ("         pixel_count: ") + String (pixel_count));
     // DEBUG_V (String ("       BufferAddress: ") + String ((uint32_t)(c_OutputCommon::GetBufferAddress ())));
 
+    // the buffer may have moved even if the size did not change
+    MarkBufferDirty ();
+
     do // once
     {
         // are we changing size?
@@ -181,6 +193,8 @@ bool c_OutputPixel::SetConfig (ArduinoJson::JsonObject& jsonConfig)
     setFromJSON (InterFrameGapInMicroSec, jsonConfig, CN_interframetime);
     setFromJSON (PrependNullPixelCount, jsonConfig, CN_prependnullcount);
     setFromJSON (AppendNullPixelCount, jsonConfig, CN_appendnullcount);
+    setFromJSON (HighFrameRate, jsonConfig, CN_hfr);
+    setFromJSON (MaxFrameRate, jsonConfig, CN_maxfps);
 
     // DEBUG_V (String ("PrependNullPixelCount: ") + String (PrependNullPixelCount));
     // DEBUG_V (String (" AppendNullPixelCount: ") + String (AppendNullPixelCount));
@@ -205,8 +219,12 @@ bool c_OutputPixel::SetConfig (ArduinoJson::JsonObject& jsonConfig)
     ZagPixelCount  = (2 > zig_size) ? pixel_count + 1 : zig_size + 1;
     PixelGroupSize = (2 > PixelGroupSize) ? 1 : PixelGroupSize;
 
+    SelectPixelEncoders ();
     SetFrameDurration(IntensityBitTimeInUs, BlockSize, BlockDelayUs);
 
+    // the wire data needs to be rebuilt using the new settings
+    MarkBufferDirty ();
+
     // DEBUG_V (String ("ZigPixelCount: ") + String (ZigPixelCount));
     // DEBUG_V (String ("ZagPixelCount: ") + String (ZagPixelCount));
     // DEBUG_V (String ("     zig_size: ") + String (zig_size));
@@ -302,6 +320,13 @@ bool c_OutputPixel::validate ()
         response = false;
     }
 
+    if ((0 == MaxFrameRate) || (PIXEL_MAX_FRAME_RATE < MaxFrameRate))
+    {
+        logcon (CN_stars + String (F (" Requested max frame rate is out of range. Setting to ")) + String (PIXEL_DEFAULT_MAX_FRAME_RATE) + " " + CN_stars);
+        MaxFrameRate = PIXEL_DEFAULT_MAX_FRAME_RATE;
+        response = false;
+    }
+
     // DEBUG_END;
     return response;
 
@@ -321,7 +346,13 @@ void c_OutputPixel::SetFrameDurration (float IntensityBitTimeInUs, uint16_t Bloc
     int TotalBlockDelayUs           = int (float (NumBlocks) * BlockDelayUs);
 
     uint32_t _FrameMinDurationInMicroSec = (IntensityBitTimeInUs * TotalBits) + InterFrameGapInMicroSec + TotalBlockDelayUs;
-    FrameMinDurationInMicroSec = max(uint32_t(25000), _FrameMinDurationInMicroSec);
+
+    // In high frame rate mode the only limits are the time it takes to put the frame
+    // on the wire (including the reset gap) and the configured frame rate ceiling.
+    FrameRateLimitInMicroSec = HighFrameRate ?
+                                        uint32_t(MicroSecondsInASecond / MaxFrameRate) :
+                                        uint32_t(PIXEL_DEFAULT_MIN_FRAME_TIME_US);
+    FrameMinDurationInMicroSec = max(FrameRateLimitInMicroSec, _FrameMinDurationInMicroSec);
 
     // DEBUG_V (String ("           OutputBufferSize: ") + String (OutputBufferSize));
     // DEBUG_V (String ("             PixelGroupSize: ") + String (PixelGroupSize));
@@ -340,6 +371,7 @@ void c_OutputPixel::SetFrameDurration (float IntensityBitTimeInUs, uint16_t Bloc
     // DEBUG_V (String ("       IntensityBitTimeInUs: ") + String (IntensityBitTimeInUs));
     // DEBUG_V (String ("    InterFrameGapInMicroSec: ") + String (InterFrameGapInMicroSec));
     // DEBUG_V (String ("_FrameMinDurationInMicroSec: ") + String (_FrameMinDurationInMicroSec));
+    // DEBUG_V (String ("   FrameRateLimitInMicroSec: ") + String (FrameRateLimitInMicroSec));
     // DEBUG_V (String (" FrameMinDurationInMicroSec: ") + String (FrameMinDurationInMicroSec));
 
     // DEBUG_END;
@@ -351,15 +383,19 @@ void IRAM_ATTR c_OutputPixel::StartNewFrame ()
 {
     // DEBUG_START;
 
-#ifdef USE_PIXEL_DEBUG_COUNTERS
     if (ISR_MoreDataToSend ())
     {
+        ++Telemetry.AbortedFrames;
+#ifdef USE_PIXEL_DEBUG_COUNTERS
         AbortFrameCounter++;
+#endif // def USE_PIXEL_DEBUG_COUNTERS
     }
+#ifdef USE_PIXEL_DEBUG_COUNTERS
     FrameStartCounter++;
 #endif // def USE_PIXEL_DEBUG_COUNTERS
 
-    NextPixelToSend = GetBufferAddress();
+    LatchFrameBuffer();
+    NextPixelToSend = GetFrameBufferAddress();
     FramePrependDataCurrentIndex    = 0;
     FrameAppendDataCurrentIndex     = 0;
     ZigPixelCurrentCount            = 1;
@@ -375,6 +411,18 @@ void IRAM_ATTR c_OutputPixel::StartNewFrame ()
     FrameState     = (FramePrependDataSize)  ? FrameState_t::FramePrependData : FrameState_t::FrameSendPixels;
     PixelSendState = (PrependNullPixelCount) ? PixelSendState_t::PixelPrependNulls : PixelSendState_t::PixelSendIntensity;
 
+    if (nullptr == NextPixelToSend)
+    {
+        // no buffer has been allocated for this output
+        FrameState = FrameState_t::FrameDone;
+    }
+#ifdef SUPPORT_OutputType_GECE
+    else if ((OutputType == OTYPE_t::OutputType_GECE) && (nullptr != pGECELastSent) && (nullptr != pGECEPackets))
+    {
+        BuildGECEChangeList ();
+    }
+#endif // def SUPPORT_OutputType_GECE
+
 #ifdef USE_PIXEL_DEBUG_COUNTERS
     SentPixels         = SentPixelsCount;
     PixelsToSend       = pixel_count;
@@ -387,6 +435,87 @@ void IRAM_ATTR c_OutputPixel::StartNewFrame ()
     // DEBUG_END;
 } // StartNewFrame
 
+#ifdef SUPPORT_OutputType_GECE
+//----------------------------------------------------------------------------
+/*
+    GECE bulbs are individually addressed and keep their color until told
+    otherwise. Run the normal encoder over the whole frame now and keep only
+    the bulbs whose packet differs from the last one they were sent. The frame
+    period then follows the number of bulbs that actually go on the wire.
+*/
+void c_OutputPixel::BuildGECEChangeList ()
+{
+    // DEBUG_START;
+
+    uint32_t Now = millis ();
+    bool SendAllBulbs = (0 != GECEFullRefreshMs) && ((Now - GECELastFullRefreshMs) >= GECEFullRefreshMs);
+    if (SendAllBulbs)
+    {
+        GECELastFullRefreshMs = Now;
+    }
+
+    NumGECEPackets = 0;
+    uint32_t BulbId = 0;
+    while ((FrameState_t::FrameDone != FrameState) && (BulbId < GECE_MAX_BULBS))
+    {
+        // the list holds the packets before inversion. The ISR inverts them on the way out
+        uint32_t Packet = ISR_GetNextIntensityToSend ();
+        if (InvertData)
+        {
+            Packet = ~Packet;
+        }
+
+        if (SendAllBulbs || (Packet != pGECELastSent[BulbId]))
+        {
+            pGECELastSent[BulbId]          = Packet;
+            pGECEPackets[NumGECEPackets++] = Packet;
+        }
+        ++BulbId;
+    }
+
+    GECEBulbsSkipped += BulbId - NumGECEPackets;
+    if (NumGECEPackets < BulbId)
+    {
+        ++GECEPartialFrames;
+    }
+    else
+    {
+        ++GECEFullFrames;
+    }
+
+    GECEPacketIndex = 0;
+    FrameState      = (NumGECEPackets) ? FrameState_t::FrameSendGECEList : FrameState_t::FrameDone;
+
+    uint32_t WireTimeInMicroSec = (NumGECEPackets * GECEPacketTimeInUs) + InterFrameGapInMicroSec;
+    FrameMinDurationInMicroSec  = max (FrameRateLimitInMicroSec, WireTimeInMicroSec);
+
+    // DEBUG_END;
+} // BuildGECEChangeList
+
+//----------------------------------------------------------------------------
+/*
+    In change only mode a frame can be a single bulb so the render task has to
+    be ready for that frame, not the whole string. The frame rate limit still
+    applies so without high frame rate mode this stays at 40 fps.
+*/
+uint32_t c_OutputPixel::GetShortestFrameDurationInMicroSec ()
+{
+    // DEBUG_START;
+
+    uint32_t Response = FrameMinDurationInMicroSec;
+
+    if (nullptr != pGECELastSent)
+    {
+        Response = max (FrameRateLimitInMicroSec, GECEPacketTimeInUs + InterFrameGapInMicroSec);
+    }
+
+    // DEBUG_END;
+
+    return Response;
+
+} // GetShortestFrameDurationInMicroSec
+#endif // def SUPPORT_OutputType_GECE
+
 //----------------------------------------------------------------------------
 void c_OutputPixel::SetIntensityDataWidth(uint32_t DataWidth)
 {
@@ -571,6 +700,18 @@ uint32_t IRAM_ATTR c_OutputPixel::ISR_GetNextIntensityToSend ()
             break;
         } // case FrameState_t::FrameAppendData
 
+#ifdef SUPPORT_OutputType_GECE
+        case FrameState_t::FrameSendGECEList:
+        {
+            response = pGECEPackets[GECEPacketIndex];
+            if (++GECEPacketIndex >= NumGECEPackets)
+            {
+                FrameState = FrameState_t::FrameDone;
+            }
+            break;
+        } // case FrameState_t::FrameSendGECEList
+#endif // def SUPPORT_OutputType_GECE
+
         case FrameState_t::FrameDone:
         {
 #ifdef USE_PIXEL_DEBUG_COUNTERS
@@ -597,6 +738,76 @@ uint32_t IRAM_ATTR c_OutputPixel::ISR_GetNextIntensityToSend ()
 
 } // NextIntensityToSend
 
+//----------------------------------------------------------------------------
+/*
+    Bulk version of ISR_GetNextIntensityToSend. The transports call this once
+    per refill instead of once per intensity. Pixel data is the bulk of every
+    frame so it gets a tight loop. Everything else (prepend / append data,
+    null pixels, GECE framing) goes through the state machine one value at a
+    time.
+*/
+template <typename T>
+inline size_t IRAM_ATTR c_OutputPixel::EncodeBlock (T * pTarget, size_t MaxIntensities)
+{
+    size_t   NumIntensitiesWritten = 0;
+    uint32_t InvertMask            = (InvertData) ? uint32_t(-1) : 0;
+
+    while ((NumIntensitiesWritten < MaxIntensities) && (FrameState_t::FrameDone != FrameState))
+    {
+        bool CanUseFastPath = (FrameState_t::FrameSendPixels == FrameState) &&
+                              (PixelSendState_t::PixelSendIntensity == PixelSendState) &&
+                              (0 == PixelPrependDataSize);
+#ifdef SUPPORT_OutputType_GECE
+        CanUseFastPath = CanUseFastPath && (OutputType != OTYPE_t::OutputType_GECE);
+#endif // def SUPPORT_OutputType_GECE
+
+        if (!CanUseFastPath)
+        {
+            pTarget[NumIntensitiesWritten++] = T(ISR_GetNextIntensityToSend ());
+            continue;
+        }
+
+        size_t NumEncoded = EncodePixelData (&pTarget[NumIntensitiesWritten], (MaxIntensities - NumIntensitiesWritten));
+        if (NumEncoded)
+        {
+            NumIntensitiesWritten += NumEncoded;
+            continue;
+        }
+
+        // No specialized encoder for this config.
+        // GetIntensityData changes the state when the last pixel has been sent
+        do
+        {
+#ifdef USE_PIXEL_DEBUG_COUNTERS
+            GetNextIntensityToSendCounter++;
+            FrameSendPixelsCounter++;
+            PixelSendIntensityCounter++;
+            IntensityBytesSent++;
+#endif // def USE_PIXEL_DEBUG_COUNTERS
+            pTarget[NumIntensitiesWritten++] = T(GetIntensityData () ^ InvertMask);
+        } while ((NumIntensitiesWritten < MaxIntensities) &&
+                 (FrameState_t::FrameSendPixels == FrameState) &&
+                 (PixelSendState_t::PixelSendIntensity == PixelSendState));
+    }
+
+    return NumIntensitiesWritten;
+
+} // EncodeBlock
+
+//----------------------------------------------------------------------------
+size_t IRAM_ATTR c_OutputPixel::ISR_EncodeBlock (uint32_t * pTarget, size_t MaxIntensities)
+{
+    return EncodeBlock (pTarget, MaxIntensities);
+} // ISR_EncodeBlock
+
+#ifdef SUPPORT_SPI_OUTPUT
+//----------------------------------------------------------------------------
+size_t IRAM_ATTR c_OutputPixel::ISR_EncodeBlock (uint8_t * pTarget, size_t MaxIntensities)
+{
+    return EncodeBlock (pTarget, MaxIntensities);
+} // ISR_EncodeBlock
+#endif // def SUPPORT_SPI_OUTPUT
+
 //----------------------------------------------------------------------------
 uint32_t IRAM_ATTR c_OutputPixel::GetIntensityData()
 {
@@ -634,32 +845,7 @@ uint32_t IRAM_ATTR c_OutputPixel::GetIntensityData()
         ++SentPixelsCount;
         if (SentPixelsCount >= pixel_count)
         {
-#ifdef USE_PIXEL_DEBUG_COUNTERS
-            FrameEndCounter++;
-#endif // def USE_PIXEL_DEBUG_COUNTERS
-
-            // response = 0xaa;
-            if (AppendNullPixelCount)
-            {
-                PixelPrependDataCurrentIndex = 0;
-                PixelIntensityCurrentIndex = 0;
-                AppendNullPixelCurrentCount = 0;
-
-                PixelSendState = PixelSendState_t::PixelAppendNulls;
-            }
-            else if (FrameAppendDataSize)
-            {
-                // FrameAppendDataCurrentIndex = 0;
-                FrameState = FrameState_t::FrameAppendData;
-            }
-            else
-            {
-#ifdef USE_PIXEL_DEBUG_COUNTERS
-                IntensityBytesSentLastFrame = IntensityBytesSent;
-#endif // def USE_PIXEL_DEBUG_COUNTERS
-                FrameState = FrameState_t::FrameDone;
-            }
-
+            PixelDataComplete ();
             break;
         }
 
@@ -698,94 +884,313 @@ uint32_t IRAM_ATTR c_OutputPixel::GetIntensityData()
 
         break;
 
-#else // !ADJUST_INTENSITY_AT_ISR Adjustments are made at write time
-        response = pOutputBuffer[PixelIntensityCurrentIndex];
+#else // !ADJUST_INTENSITY_AT_ISR Adjustments were made when the frame was latched
+        response = NextPixelToSend[PixelIntensityCurrentIndex];
 
-        ++PixelIntensityCurrentIndex;
-        if (PixelIntensityCurrentIndex >= OutputBufferSize)
+        // has the pixel completed?
+        if (++PixelIntensityCurrentIndex < NumIntensityBytesPerPixel)
         {
-            // response = 0xaa;
-            if (AppendNullPixelCount)
-            {
-                PixelPrependDataCurrentIndex = 0;
-                PixelIntensityCurrentIndex = 0;
-                AppendNullPixelCurrentCount = 0;
+            break;
+        }
 
-                PixelSendState = PixelSendState_t::PixelAppendNulls;
-            }
-            else if (FrameAppendDataSize)
-            {
-                // FrameAppendDataCurrentIndex = 0;
-                FrameState = FrameState_t::FrameAppendData;
-            }
-            else
-            {
-#ifdef USE_PIXEL_DEBUG_COUNTERS
-                IntensityBytesSentLastFrame = IntensityBytesSent;
-#endif // def USE_PIXEL_DEBUG_COUNTERS
+        PixelIntensityCurrentIndex = 0;
+        PixelPrependDataCurrentIndex = 0;
 
-                FrameState = FrameState_t::FrameDone;
-            }
+        // has the group completed?
+        if (++PixelGroupSizeCurrentCount < PixelGroupSize)
+        {
+            // not finished with the group yet
+            break;
+        }
+
+        // refresh the group count
+        PixelGroupSizeCurrentCount = 0;
 
+        if (++SentPixelsCount >= pixel_count)
+        {
+            PixelDataComplete ();
             break;
         }
-#endif // ! def ADJUST_INTENSITY_AT_WRITE
+
+        // the frame buffer is already in wire order
+        NextPixelToSend += NumIntensityBytesPerPixel;
+
+        break;
+#endif // ! def ADJUST_INTENSITY_AT_ISR
 
     } while (false);
     return response;
 }
 
 //----------------------------------------------------------------------------
-inline size_t c_OutputPixel::CalculateIntensityOffset(size_t ChannelId)
+///< All of the pixels have been sent. Move on to the next part of the frame
+inline void IRAM_ATTR c_OutputPixel::PixelDataComplete ()
 {
-    // DEBUG_START;
+#ifdef USE_PIXEL_DEBUG_COUNTERS
+    FrameEndCounter++;
+#endif // def USE_PIXEL_DEBUG_COUNTERS
 
-    // DEBUG_V(String("              ChannelId: 0x") + String(ChannelId, HEX));
-    size_t PixelId = ChannelId / size_t(NumIntensityBytesPerPixel);
-    // DEBUG_V(String("                PixelId: 0x") + String(PixelId, HEX));
+    if (AppendNullPixelCount)
+    {
+        PixelPrependDataCurrentIndex = 0;
+        PixelIntensityCurrentIndex = 0;
+        AppendNullPixelCurrentCount = 0;
 
-    // are we doing a zig zag operation?
-    if ((zig_size > 1) && (PixelId >= zig_size))
+        PixelSendState = PixelSendState_t::PixelAppendNulls;
+    }
+    else if (FrameAppendDataSize)
+    {
+        // FrameAppendDataCurrentIndex = 0;
+        FrameState = FrameState_t::FrameAppendData;
+    }
+    else
     {
-        // DEBUG_V(String("               zig_size: 0x") + String(zig_size, HEX));
-        size_t ZigZagGroupId = PixelId / zig_size;
-        // DEBUG_V(String("          ZigZagGroupId: 0x") + String(ZigZagGroupId, HEX));
-
-        // is this a backwards group
-        if (0 != (ZigZagGroupId & 0x1))
-        {
-            // DEBUG_V("Backwards Group");
-            size_t zigoffset = PixelId % zig_size;
-            // DEBUG_V(String("              zigoffset: 0x") + String(zigoffset, HEX));
-            size_t BaseGroupPixelId = ZigZagGroupId * zig_size;
-            PixelId = BaseGroupPixelId + (zig_size - 1) - zigoffset;
-            // DEBUG_V(String("       BaseGroupPixelId: 0x") + String(BaseGroupPixelId, HEX));
-            // DEBUG_V(String("                PixelId: 0x") + String(PixelId, HEX));
+#ifdef USE_PIXEL_DEBUG_COUNTERS
+        IntensityBytesSentLastFrame = IntensityBytesSent;
+#endif // def USE_PIXEL_DEBUG_COUNTERS
+        FrameState = FrameState_t::FrameDone;
+    }
+
+} // PixelDataComplete
+
+//----------------------------------------------------------------------------
+/*
+    Same output as GetIntensityData() but with the config specific decisions
+    made at compile time. BytesPerPixel lets the compiler unroll the color
+    loop and ZigZag / Grouping remove the traversal code that is not needed.
+    Invert is applied with an XOR mask so it costs nothing when it is off.
+
+    On the ESP8266 this also does the gamma, brightness and color order
+    lookups. On the ESP32 those were done by UpdateFrameBuffer, so this is a
+    per pixel copy and the gain is only skipping the per intensity state
+    machine in GetIntensityData().
+
+    Leaves the pixel state exactly where GetIntensityData() would have so the
+    generic code can pick up at the end of the pixel data.
+*/
+template <typename T, size_t BytesPerPixel, bool ZigZag, bool Grouping>
+size_t IRAM_ATTR c_OutputPixel::EncodePixelData (T * pTarget, size_t MaxIntensities)
+{
+    size_t    NumIntensitiesWritten = 0;
+    uint32_t  InvertMask            = (InvertData) ? uint32_t(-1) : 0;
+    uint32_t  Brightness            = AdjustedBrightness;
+    uint8_t * pPixel                = NextPixelToSend;
+    size_t    ColorIndex            = PixelIntensityCurrentIndex;
+    uint8_t   Offsets[BytesPerPixel];
+
+    // local copies so the writes to pTarget do not force reloads
+    for (size_t index = 0; index < BytesPerPixel; ++index)
+    {
+#ifdef ADJUST_INTENSITY_AT_ISR
+        Offsets[index] = ColorOffsets.Array[index];
+#else
+        // color order was applied when the frame was latched
+        Offsets[index] = index;
+#endif // def ADJUST_INTENSITY_AT_ISR
+    }
+
+    while (NumIntensitiesWritten < MaxIntensities)
+    {
+        if ((0 == ColorIndex) && (BytesPerPixel <= (MaxIntensities - NumIntensitiesWritten)))
+        {
+            // send a whole pixel
+            for (size_t index = 0; index < BytesPerPixel; ++index)
+            {
+#ifdef ADJUST_INTENSITY_AT_ISR
+                uint32_t Intensity = uint8_t((uint32_t(gamma_table[pPixel[Offsets[index]]]) * Brightness) >> 8);
+#else
+                uint32_t Intensity = pPixel[Offsets[index]];
+#endif // def ADJUST_INTENSITY_AT_ISR
+                pTarget[NumIntensitiesWritten++] = T(Intensity ^ InvertMask);
+            }
         }
+        else
+        {
+            // partial pixel at the end of a block
+#ifdef ADJUST_INTENSITY_AT_ISR
+            uint32_t Intensity = uint8_t((uint32_t(gamma_table[pPixel[Offsets[ColorIndex]]]) * Brightness) >> 8);
+#else
+            uint32_t Intensity = pPixel[Offsets[ColorIndex]];
+#endif // def ADJUST_INTENSITY_AT_ISR
+            pTarget[NumIntensitiesWritten++] = T(Intensity ^ InvertMask);
+            if (++ColorIndex < BytesPerPixel)
+            {
+                continue;
+            }
+        }
+        ColorIndex = 0;
+
+        if (Grouping)
+        {
+            if (++PixelGroupSizeCurrentCount < PixelGroupSize)
+            {
+                // send the same pixel again
+                continue;
+            }
+            PixelGroupSizeCurrentCount = 0;
+        }
+
+        if (++SentPixelsCount >= pixel_count)
+        {
+            PixelDataComplete ();
+            break;
+        }
+
+        if (!ZigZag)
+        {
+            pPixel += BytesPerPixel;
+            continue;
+        }
+
+        // have we completed the forward traverse
+        if (++ZigPixelCurrentCount < ZigPixelCount)
+        {
+            pPixel += BytesPerPixel;
+            continue;
+        }
+
+        if (0 == ZagPixelCurrentCount)
+        {
+            // first backward pixel
+            pPixel += BytesPerPixel * ZagPixelCount;
+        }
+
+        // have we completed the backward traverse
+        if (++ZagPixelCurrentCount < ZagPixelCount)
+        {
+            pPixel -= BytesPerPixel;
+            continue;
+        }
+
+        // move to next forward pixel
+        pPixel += BytesPerPixel * (ZagPixelCount - 1);
+
+        // refresh the zigZag
+        ZigPixelCurrentCount = 1;
+        ZagPixelCurrentCount = 0;
+    }
+
+    NextPixelToSend            = pPixel;
+    PixelIntensityCurrentIndex = ColorIndex;
+
+#ifdef USE_PIXEL_DEBUG_COUNTERS
+    IntensityBytesSent += NumIntensitiesWritten;
+#endif // def USE_PIXEL_DEBUG_COUNTERS
+
+    return NumIntensitiesWritten;
+
+} // EncodePixelData
+
+//----------------------------------------------------------------------------
+/*
+    The zig zag variants are only built when the ISR does the adjustments.
+    Otherwise zig zag has already been applied by UpdateFrameBuffer and they
+    would just take up IRAM.
+*/
+template <size_t BytesPerPixel>
+void c_OutputPixel::SetPixelEncoders (bool ZigZag, bool Grouping)
+{
+    // DEBUG_START;
+
+#ifdef ADJUST_INTENSITY_AT_ISR
+    if (ZigZag && Grouping)
+    {
+        pPixelEncoder32 = &c_OutputPixel::EncodePixelData<uint32_t, BytesPerPixel, true,  true>;
+#ifdef SUPPORT_SPI_OUTPUT
+        pPixelEncoder8  = &c_OutputPixel::EncodePixelData<uint8_t,  BytesPerPixel, true,  true>;
+#endif // def SUPPORT_SPI_OUTPUT
+    }
+    else if (ZigZag)
+    {
+        pPixelEncoder32 = &c_OutputPixel::EncodePixelData<uint32_t, BytesPerPixel, true,  false>;
+#ifdef SUPPORT_SPI_OUTPUT
+        pPixelEncoder8  = &c_OutputPixel::EncodePixelData<uint8_t,  BytesPerPixel, true,  false>;
+#endif // def SUPPORT_SPI_OUTPUT
+    }
+    else
+#endif // def ADJUST_INTENSITY_AT_ISR
+    if (Grouping)
+    {
+        pPixelEncoder32 = &c_OutputPixel::EncodePixelData<uint32_t, BytesPerPixel, false, true>;
+#ifdef SUPPORT_SPI_OUTPUT
+        pPixelEncoder8  = &c_OutputPixel::EncodePixelData<uint8_t,  BytesPerPixel, false, true>;
+#endif // def SUPPORT_SPI_OUTPUT
+    }
+    else
+    {
+        pPixelEncoder32 = &c_OutputPixel::EncodePixelData<uint32_t, BytesPerPixel, false, false>;
+#ifdef SUPPORT_SPI_OUTPUT
+        pPixelEncoder8  = &c_OutputPixel::EncodePixelData<uint8_t,  BytesPerPixel, false, false>;
+#endif // def SUPPORT_SPI_OUTPUT
     }
 
-    size_t ColorOrderIndex = ChannelId % size_t(NumIntensityBytesPerPixel);
-    if (size_t(NumIntensityBytesPerPixel) > ChannelId)
+    // DEBUG_END;
+} // SetPixelEncoders
+
+//----------------------------------------------------------------------------
+///< Pick the pixel data encoder that matches the current config
+void c_OutputPixel::SelectPixelEncoders ()
+{
+    // DEBUG_START;
+
+    // default to the generic state machine
+    pPixelEncoder32 = nullptr;
+#ifdef SUPPORT_SPI_OUTPUT
+    pPixelEncoder8  = nullptr;
+#endif // def SUPPORT_SPI_OUTPUT
+
+#ifdef ADJUST_INTENSITY_AT_ISR
+    bool ZigZag   = (1 < zig_size) && (zig_size < pixel_count);
+#else
+    // zig zag was applied when the frame was latched
+    bool ZigZag   = false;
+#endif // def ADJUST_INTENSITY_AT_ISR
+    bool Grouping = (1 < PixelGroupSize);
+
+    if (3 == NumIntensityBytesPerPixel)
     {
-        ColorOrderIndex = ChannelId;
+        SetPixelEncoders<3> (ZigZag, Grouping);
+    }
+    else if (4 == NumIntensityBytesPerPixel)
+    {
+        SetPixelEncoders<4> (ZigZag, Grouping);
     }
-    size_t ColorOrderId = ColorOffsets.Array[ColorOrderIndex];
-    size_t PixelIntensityBaseId = PixelId * size_t(NumIntensityBytesPerPixel);
-    size_t TargetBufferIntensityId = PixelIntensityBaseId + ColorOrderId;
 
-    // DEBUG_V(String("              ChannelId: 0x") + String(ChannelId, HEX));
-    // DEBUG_V(String("                PixelId: 0x") + String(PixelId, HEX));
-    // DEBUG_V(String("        ColorOrderIndex: 0x") + String(ColorOrderIndex, HEX));
-    // DEBUG_V(String("           ColorOrderId: 0x") + String(ColorOrderId, HEX));
-    // DEBUG_V(String("   PixelIntensityBaseId: 0x") + String(PixelIntensityBaseId, HEX));
-    // DEBUG_V(String("TargetBufferIntensityId: 0x") + String(TargetBufferIntensityId, HEX));
+    // DEBUG_V (String ("ZigZag: ") + String (ZigZag) + " Grouping: " + String (Grouping));
 
     // DEBUG_END;
-    return TargetBufferIntensityId;
+} // SelectPixelEncoders
 
-} // CalculateIntensityOffset
+//----------------------------------------------------------------------------
+void c_OutputPixel::MarkBufferDirty ()
+{
+    // DEBUG_START;
+
+    // the dirty range is only ever changed while holding the buffer lock
+    OutputMgr.LockBuffer ();
+    DirtyStartChannelId = 0;
+    DirtyEndChannelId   = OutputBufferSize;
+    OutputMgr.UnlockBuffer ();
+
+    // DEBUG_END;
+} // MarkBufferDirty
 
 //----------------------------------------------------------------------------
+///< Called while holding the buffer lock
+void c_OutputPixel::LatchDirtyRange ()
+{
+    // DEBUG_START;
+
+    LatchedStartChannelId = min(LatchedStartChannelId, DirtyStartChannelId);
+    LatchedEndChannelId   = max(LatchedEndChannelId,   DirtyEndChannelId);
+    DirtyStartChannelId   = size_t(-1);
+    DirtyEndChannelId     = 0;
+
+    // DEBUG_END;
+} // LatchDirtyRange
+
+//----------------------------------------------------------------------------
+///< Called by the output manager while it holds the buffer lock
 void c_OutputPixel::WriteChannelData(size_t StartChannelId, size_t ChannelCount, byte *pSourceData)
 {
     // DEBUG_START;
@@ -793,21 +1198,12 @@ void c_OutputPixel::WriteChannelData(size_t StartChannelId, size_t ChannelCount,
     // DEBUG_V(String("         StartChannelId: 0x") + String(StartChannelId, HEX));
     // DEBUG_V(String("           ChannelCount: 0x") + String(ChannelCount, HEX));
 
-#ifdef ADJUST_INTENSITY_AT_ISR
     memcpy(&pOutputBuffer[StartChannelId], pSourceData, ChannelCount);
-#else
 
-    size_t EndChannelId = StartChannelId + ChannelCount;
-    size_t SourceDataIndex = 0;
-    for (size_t currentChannelId = StartChannelId; currentChannelId < EndChannelId; ++currentChannelId, ++SourceDataIndex)
-    {
-        size_t CurrentIntensityData = gamma_table[pSourceData[SourceDataIndex]];
-        CurrentIntensityData = uint8_t((uint32_t(CurrentIntensityData) * AdjustedBrightness) >> 8);
-
-        pOutputBuffer[CalculateIntensityOffset(currentChannelId)] = CurrentIntensityData;
-    }
-
-#endif // def ADJUST_INTENSITY_AT_ISR
+#ifndef ADJUST_INTENSITY_AT_ISR
+    DirtyStartChannelId = min(DirtyStartChannelId, StartChannelId);
+    DirtyEndChannelId   = max(DirtyEndChannelId, (StartChannelId + ChannelCount));
+#endif // ndef ADJUST_INTENSITY_AT_ISR
 
     // DEBUG_END;
 
@@ -820,22 +1216,91 @@ void c_OutputPixel::ReadChannelData(size_t StartChannelId, size_t ChannelCount,
 
     // DEBUG_V(String("         StartChannelId: 0x") + String(StartChannelId, HEX));
     // DEBUG_V(String("           ChannelCount: 0x") + String(ChannelCount, HEX));
-#ifdef ADJUST_INTENSITY_AT_ISR
+
+    // the output buffer always holds the data as it was written
     memcpy(pTargetData, &pOutputBuffer[StartChannelId], ChannelCount);
-#else  // !ADJUST_INTENSITY_AT_ISR
 
-    size_t EndChannelId = StartChannelId + ChannelCount;
-    size_t SourceDataIndex = 0;
-    for (size_t currentChannelId = StartChannelId; currentChannelId < EndChannelId; ++currentChannelId, ++SourceDataIndex)
+    // DEBUG_END;
+
+} // ReadChannelData
+
+//----------------------------------------------------------------------------
+/*
+    Called at frame start when new data has been latched. The output buffer
+    keeps the data as the inputs wrote it. When the adjustments are not made
+    in the ISR, the pixels that changed since the last latch are converted
+    into wire order (gamma, brightness, color order, zig zag) in the frame
+    buffer. Since the original data is kept, a change in gamma or brightness
+    just marks the whole buffer dirty and the next latch rebuilds it.
+
+    LatchFrameBuffer holds the buffer lock, so no input can write (and move
+    the dirty range) between reading the range and resetting it. While an
+    input latches explicitly, LatchFrame copies the output buffer and moves
+    the dirty range over to the latched range. We then convert from that
+    copy so writes made after the latch wait for the next one.
+*/
+void c_OutputPixel::UpdateFrameBuffer ()
+{
+    // DEBUG_START;
+
+#ifdef ADJUST_INTENSITY_AT_ISR
+    c_OutputCommon::UpdateFrameBuffer ();
+#else
+    do // once
     {
-        uint8_t CurrentIntensityData = pOutputBuffer[CalculateIntensityOffset(currentChannelId)];
-        // CurrentIntensityData = gamma_table[CurrentIntensityData];
-        CurrentIntensityData = uint8_t((uint32_t(CurrentIntensityData << 8) / AdjustedBrightness));
-        pTargetData[SourceDataIndex] = CurrentIntensityData;
-    }
+        // without a copy, every latch takes whatever has been written so far
+        if (pLatchSource == pOutputBuffer)
+        {
+            LatchDirtyRange ();
+        }
+
+        size_t StartChannelId = LatchedStartChannelId;
+        size_t EndChannelId   = LatchedEndChannelId;
+        LatchedStartChannelId = size_t(-1);
+        LatchedEndChannelId   = 0;
 
-#endif // !def ADJUST_INTENSITY_AT_ISR
+        size_t NumPixels = min(pixel_count, (OutputBufferSize / NumIntensityBytesPerPixel));
+        size_t FirstPixelId = StartChannelId / NumIntensityBytesPerPixel;
+        size_t EndPixelId   = min(NumPixels, ((EndChannelId + NumIntensityBytesPerPixel - 1) / NumIntensityBytesPerPixel));
+
+        if (FirstPixelId >= EndPixelId)
+        {
+            // DEBUG_V ("Nothing has changed");
+            break;
+        }
+
+        size_t   ZigZagSize = ((1 < zig_size) && (zig_size < NumPixels)) ? zig_size : NumPixels;
+        size_t   GroupId    = FirstPixelId / ZigZagSize;
+        size_t   GroupStart = GroupId * ZigZagSize;
+        size_t   GroupEnd   = min(NumPixels, (GroupStart + ZigZagSize));
+        uint8_t  Offsets[4];
+        memcpy(Offsets, ColorOffsets.Array, sizeof(Offsets));
+
+        uint8_t * pSource = &pLatchSource[FirstPixelId * NumIntensityBytesPerPixel];
+        for (size_t PixelId = FirstPixelId; PixelId < EndPixelId; ++PixelId, pSource += NumIntensityBytesPerPixel)
+        {
+            if (PixelId >= GroupEnd)
+            {
+                ++GroupId;
+                GroupStart = GroupEnd;
+                GroupEnd   = min(NumPixels, (GroupStart + ZigZagSize));
+            }
+
+            // odd groups are sent in reverse order
+            size_t WirePixelId = (GroupId & 0x1) ? (GroupStart + GroupEnd - 1 - PixelId) : PixelId;
+            uint8_t * pTarget = &pFrameBuffer[WirePixelId * NumIntensityBytesPerPixel];
+
+            for (size_t ColorIndex = 0; ColorIndex < NumIntensityBytesPerPixel; ++ColorIndex)
+            {
+                pTarget[ColorIndex] = uint8_t((uint32_t(gamma_table[pSource[Offsets[ColorIndex]]]) * AdjustedBrightness) >> 8);
+            }
+        }
+
+        // DEBUG_V (String ("Converted pixels ") + String (FirstPixelId) + " to " + String (EndPixelId));
+
+    } while (false);
+#endif // def ADJUST_INTENSITY_AT_ISR
 
     // DEBUG_END;
 
-} // ReadChannelData
+} // UpdateFrameBuffer
@@ -32,6 +32,7 @@ private:
         FramePrependData,
         FrameSendPixels,
         FrameAppendData,
+        FrameSendGECEList,
         FrameDone
     };
 
@@ -52,11 +53,20 @@ public:
              void         SetInvertData (bool _InvertData) { InvertData = _InvertData; }
     virtual  void         WriteChannelData (size_t StartChannelId, size_t ChannelCount, byte *pSourceData);
     virtual  void         ReadChannelData (size_t StartChannelId, size_t ChannelCount, byte *pTargetData);
+    virtual  void         MarkBufferDirty ();
+    virtual  void         LatchDirtyRange ();
+#ifdef SUPPORT_OutputType_GECE
+    virtual  uint32_t     GetShortestFrameDurationInMicroSec ();
+#endif // def SUPPORT_OutputType_GECE
     inline   void         SetIntensityBitTimeInUS (float value) { IntensityBitTimeInUs = value; }
              void         SetIntensityDataWidth(uint32_t value);
              void         StartNewFrame();
     bool     IRAM_ATTR    ISR_MoreDataToSend () { return FrameState_t::FrameDone != FrameState; }
     uint32_t IRAM_ATTR    ISR_GetNextIntensityToSend ();
+    size_t   IRAM_ATTR    ISR_EncodeBlock (uint32_t * pTarget, size_t MaxIntensities); ///< Fill up to MaxIntensities values. Returns the number written
+#ifdef SUPPORT_SPI_OUTPUT
+    size_t   IRAM_ATTR    ISR_EncodeBlock (uint8_t  * pTarget, size_t MaxIntensities); ///< Fill up to MaxIntensities values. Returns the number written
+#endif // def SUPPORT_SPI_OUTPUT
     void                  SetPixelCount(size_t value) {pixel_count = value;}
     size_t                GetPixelCount() {return pixel_count;}
 
@@ -69,9 +79,24 @@ protected:
     uint16_t  InterFrameGapInMicroSec = 300;
 
     void SetFrameDurration (float IntensityBitTimeInUs, uint16_t BlockSize = 1, float BlockDelayUs = 0.0);
+    virtual void UpdateFrameBuffer ();
+
+#ifdef SUPPORT_OutputType_GECE
+    // Change only GECE updates. The buffers belong to c_OutputGECE.
+    uint32_t  * pGECELastSent       = nullptr;  ///< Last packet sent to each bulb. nullptr = send every bulb every frame
+    uint32_t  * pGECEPackets        = nullptr;  ///< Packets to send this frame
+    uint32_t    GECEFullRefreshMs   = 0;        ///< Time between frames that send every bulb. 0 = only when pGECELastSent is invalidated
+    uint32_t    GECEPacketTimeInUs  = 0;        ///< Wire time of one bulb
+    uint32_t    GECEFullFrames      = 0;
+    uint32_t    GECEPartialFrames   = 0;
+    uint32_t    GECEBulbsSkipped    = 0;
+#endif // def SUPPORT_OutputType_GECE
 
 private:
 #define PIXEL_DEFAULT_INTENSITY_BYTES_PER_PIXEL 3
+#define PIXEL_DEFAULT_MIN_FRAME_TIME_US         25000   // 40 fps
+#define PIXEL_DEFAULT_MAX_FRAME_RATE            200
+#define PIXEL_MAX_FRAME_RATE                    2000
 
     size_t      NumIntensityBytesPerPixel = PIXEL_DEFAULT_INTENSITY_BYTES_PER_PIXEL;
 
@@ -99,6 +124,11 @@ private:
     size_t      BlockSize                   = 1;
     float       BlockDelayUs                = 0.0;
 
+    // high frame rate mode. Frame period is the wire time plus reset gap, limited to MaxFrameRate
+    bool        HighFrameRate               = false;
+    uint16_t    MaxFrameRate                = PIXEL_DEFAULT_MAX_FRAME_RATE;
+    uint32_t    FrameRateLimitInMicroSec    = PIXEL_DEFAULT_MIN_FRAME_TIME_US;
+
     size_t      zig_size                    = 0;
     size_t      ZigPixelCount               = 1;
     size_t      ZigPixelCurrentCount        = 1;
@@ -113,6 +143,13 @@ private:
 
     bool        InvertData                  = false;
     uint32_t    IntensityMultiplier         = 1;
+
+    // range of the output buffer that has changed since the last latch
+    size_t      DirtyStartChannelId         = 0;
+    size_t      DirtyEndChannelId           = 0;
+    // range of the latched frame that has not been converted yet
+    size_t      LatchedStartChannelId       = size_t(-1);
+    size_t      LatchedEndChannelId         = 0;
     
 // #define USE_PIXEL_DEBUG_COUNTERS
 #ifdef USE_PIXEL_DEBUG_COUNTERS
@@ -156,6 +193,11 @@ private:
     uint32_t    AdjustedBrightness  = 256;
     uint32_t    GECEPixelId         = 0;
     uint32_t    GECEBrightness      = 255;
+#ifdef SUPPORT_OutputType_GECE
+    uint32_t    NumGECEPackets          = 0;
+    uint32_t    GECEPacketIndex         = 0;
+    uint32_t    GECELastFullRefreshMs   = 0;
+#endif // def SUPPORT_OutputType_GECE
 
     // JSON configuration parameters
     String      color_order = "rgb"; ///< Pixel color order
@@ -165,8 +207,34 @@ private:
     void updateGammaTable(); ///< Generate gamma correction table
     void updateColorOrderOffsets(); ///< Update color order
     bool validate ();        ///< confirm that the current configuration is valid
-    inline size_t CalculateIntensityOffset(size_t ChannelId);
+#ifdef SUPPORT_OutputType_GECE
+    void BuildGECEChangeList ();
+#endif // def SUPPORT_OutputType_GECE
     uint32_t IRAM_ATTR GetIntensityData();
+    template <typename T> inline size_t IRAM_ATTR EncodeBlock (T * pTarget, size_t MaxIntensities);
+    inline void IRAM_ATTR PixelDataComplete ();
+
+    // Pixel data encoders that are specialized for the current config. Selected by SelectPixelEncoders()
+    template <typename T, size_t BytesPerPixel, bool ZigZag, bool Grouping>
+    size_t IRAM_ATTR EncodePixelData (T * pTarget, size_t MaxIntensities);
+    template <size_t BytesPerPixel>
+    void SetPixelEncoders (bool ZigZag, bool Grouping);
+    void SelectPixelEncoders ();
+
+    typedef size_t (c_OutputPixel::*PixelEncoder32_t)(uint32_t * pTarget, size_t MaxIntensities);
+    PixelEncoder32_t pPixelEncoder32 = nullptr;
+    inline size_t IRAM_ATTR EncodePixelData (uint32_t * pTarget, size_t MaxIntensities)
+    {
+        return (nullptr == pPixelEncoder32) ? 0 : (this->*pPixelEncoder32)(pTarget, MaxIntensities);
+    }
+#ifdef SUPPORT_SPI_OUTPUT
+    typedef size_t (c_OutputPixel::*PixelEncoder8_t)(uint8_t * pTarget, size_t MaxIntensities);
+    PixelEncoder8_t pPixelEncoder8 = nullptr;
+    inline size_t IRAM_ATTR EncodePixelData (uint8_t * pTarget, size_t MaxIntensities)
+    {
+        return (nullptr == pPixelEncoder8) ? 0 : (this->*pPixelEncoder8)(pTarget, MaxIntensities);
+    }
+#endif // def SUPPORT_SPI_OUTPUT
 
     enum PixelSendState_t
     {
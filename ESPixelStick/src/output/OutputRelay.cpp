@@ -32,6 +32,10 @@ GNU General Public License for more details.
 #include "OutputRelay.hpp"
 #include "OutputCommon.hpp"
 
+#if defined(ARDUINO_ARCH_ESP32)
+#   include <driver/ledc.h>
+#endif // defined(ARDUINO_ARCH_ESP32)
+
 #define Relay_OUTPUT_ENABLED         true
 #define Relay_OUTPUT_DISABLED        false
 #define Relay_OUTPUT_INVERTED        true
@@ -45,6 +49,8 @@ GNU General Public License for more details.
 
 #if defined(ARDUINO_ARCH_ESP32)
 #   define RelayPwmFrequency         , 12000
+#   define RelayLedcSpeedMode        LEDC_LOW_SPEED_MODE
+#   define RelayLedcResolution       LEDC_TIMER_8_BIT
 #else
 #   define RelayPwmFrequency
 #endif // defined(ARDUINO_ARCH_ESP32)
@@ -81,15 +87,34 @@ c_OutputRelay::~c_OutputRelay ()
 
     if(HasBeenInitialized)
     {
+        uint8_t ChannelIndex = 0;
         for (RelayChannel_t &currentRelay : OutputList)
         {
+#if defined(ARDUINO_ARCH_ESP32)
+            if (currentRelay.LedcAttached)
+            {
+                ledc_stop (RelayLedcSpeedMode, ledc_channel_t (ChannelIndex), 0);
+                currentRelay.LedcAttached = false;
+            }
+#endif // defined(ARDUINO_ARCH_ESP32)
             if (currentRelay.Enabled)
             {
                 pinMode(currentRelay.GpioId, INPUT);
             }
             currentRelay.Enabled = Relay_OUTPUT_DISABLED;
             currentRelay.GpioId = Relay_DEFAULT_GPIO_ID;
+            ++ChannelIndex;
         }
+
+#if defined(ARDUINO_ARCH_ESP32)
+        // leave the fade service alone if someone else installed it
+        if (OwnsFadeFunction)
+        {
+            ledc_fade_func_uninstall ();
+            OwnsFadeFunction = false;
+        }
+        FadeFunctionInstalled = false;
+#endif // defined(ARDUINO_ARCH_ESP32)
     }
 
     // DEBUG_END;
@@ -146,21 +171,18 @@ bool c_OutputRelay::validate ()
         response = false;
     }
 
+#if defined(ARDUINO_ARCH_ESP32)
+    if (PwmFadeTimeMs > OM_RELAY_PWM_MAX_FADE_MS)
+    {
+        logcon (CN_stars + String (F (" Requested PWM fade time was not valid. Setting to ")) + OM_RELAY_PWM_MAX_FADE_MS + " " + CN_stars);
+        PwmFadeTimeMs = OM_RELAY_PWM_MAX_FADE_MS;
+        response = false;
+    }
+#endif // defined(ARDUINO_ARCH_ESP32)
+
     SetOutputBufferSize (Num_Channels);
-    uint8_t Channel = 0;
     for (RelayChannel_t & currentRelay : OutputList)
     {
-        if (currentRelay.Enabled)
-        {
-            #if defined(ARDUINO_ARCH_ESP32)
-               // assign GPIO to a channel and set the pwm 12 Khz frequency, 8 bit
-               ledcAttachPin(currentRelay.GpioId, Channel);
-               ledcSetup(Channel, currentRelay.PwmFrequency, 8);
-            #else
-               pinMode (currentRelay.GpioId, OUTPUT);
-            #endif
-        }
-
         if (currentRelay.Pwm)
         {
             if (currentRelay.InvertOutput)
@@ -193,14 +215,131 @@ bool c_OutputRelay::validate ()
         // DEBUGV (String ("currentRelay.OffValue: ") + String (currentRelay.OffValue));
         // DEBUGV (String ("currentRelay.Enabled: ")  + String (currentRelay.Enabled));
         // DEBUGV (String ("currentRelay.GpioId: ")   + String (currentRelay.GpioId));
-        ++Channel;
     } // for each output channel
 
+    ConfigureOutputs ();
+
     // DEBUG_END;
     return response;
 
 } // validate
 
+//----------------------------------------------------------------------------
+/*
+*   Set up the pins once per config change so that Render only has to
+*   write new values. On the ESP32 each PWM relay gets the LEDC channel
+*   with the same index. Relays that ask for the same frequency share
+*   an LEDC timer.
+*/
+void c_OutputRelay::ConfigureOutputs ()
+{
+    // DEBUG_START;
+
+#if defined(ARDUINO_ARCH_ESP32)
+    uint32_t TimerFrequencies[LEDC_TIMER_MAX];
+    uint8_t  NumTimersInUse = 0;
+
+    if ((0 != PwmFadeTimeMs) && !FadeFunctionInstalled)
+    {
+        // ESP_ERR_INVALID_STATE means someone else already installed it
+        esp_err_t ret = ledc_fade_func_install (0);
+        OwnsFadeFunction      = (ESP_OK == ret);
+        FadeFunctionInstalled = OwnsFadeFunction || (ESP_ERR_INVALID_STATE == ret);
+        if (!FadeFunctionInstalled)
+        {
+            logcon (CN_stars + String (F (" Could not enable PWM fading. Error: ")) + String (ret) + " " + CN_stars);
+        }
+    }
+#endif // defined(ARDUINO_ARCH_ESP32)
+
+    uint8_t ChannelIndex = 0;
+    for (RelayChannel_t & currentRelay : OutputList)
+    {
+        do // once
+        {
+#if defined(ARDUINO_ARCH_ESP32)
+            currentRelay.FadeActive = false;
+
+            if (!currentRelay.Enabled || !currentRelay.Pwm)
+            {
+                if (currentRelay.LedcAttached)
+                {
+                    ledc_stop (RelayLedcSpeedMode, ledc_channel_t (ChannelIndex), 0);
+                    currentRelay.LedcAttached = false;
+                }
+
+                if (currentRelay.Enabled)
+                {
+                    // gives the pin back to the GPIO output register
+                    pinMode (currentRelay.GpioId, OUTPUT);
+                }
+                break;
+            }
+
+            uint8_t TimerIndex = 0;
+            while ((TimerIndex < NumTimersInUse) && (TimerFrequencies[TimerIndex] != currentRelay.PwmFrequency))
+            {
+                ++TimerIndex;
+            }
+
+            if (TimerIndex == NumTimersInUse)
+            {
+                if (NumTimersInUse == LEDC_TIMER_MAX)
+                {
+                    logcon (CN_stars + String (F (" Too many different PWM frequencies. Relay ")) + String (ChannelIndex + 1) + F (" shares the last one. ") + CN_stars);
+                    TimerIndex = NumTimersInUse - 1;
+                }
+                else
+                {
+                    ledc_timer_config_t TimerConfig = {};
+                    TimerConfig.speed_mode      = RelayLedcSpeedMode;
+                    TimerConfig.duty_resolution = RelayLedcResolution;
+                    TimerConfig.timer_num       = ledc_timer_t (TimerIndex);
+                    TimerConfig.freq_hz         = currentRelay.PwmFrequency;
+                    TimerConfig.clk_cfg         = LEDC_AUTO_CLK;
+
+                    if (ESP_OK != ledc_timer_config (&TimerConfig))
+                    {
+                        logcon (CN_stars + String (F (" Unsupported PWM frequency ")) + String (currentRelay.PwmFrequency) + F (" for relay ") + String (ChannelIndex + 1) + " " + CN_stars);
+                        break;
+                    }
+                    TimerFrequencies[NumTimersInUse++] = currentRelay.PwmFrequency;
+                }
+            }
+
+            ledc_channel_config_t ChannelConfig = {};
+            ChannelConfig.gpio_num   = currentRelay.GpioId;
+            ChannelConfig.speed_mode = RelayLedcSpeedMode;
+            ChannelConfig.channel    = ledc_channel_t (ChannelIndex);
+            ChannelConfig.intr_type  = LEDC_INTR_DISABLE;
+            ChannelConfig.timer_sel  = ledc_timer_t (TimerIndex);
+            ChannelConfig.duty       = 0;
+            ChannelConfig.hpoint     = 0;
+
+            currentRelay.LedcAttached = (ESP_OK == ledc_channel_config (&ChannelConfig));
+            if (!currentRelay.LedcAttached)
+            {
+                logcon (CN_stars + String (F (" Could not attach PWM to GPIO ")) + String (currentRelay.GpioId) + " " + CN_stars);
+            }
+#else
+            if (currentRelay.Enabled)
+            {
+                pinMode (currentRelay.GpioId, OUTPUT);
+            }
+#endif // defined(ARDUINO_ARCH_ESP32)
+
+        } while (false);
+
+        ++ChannelIndex;
+    } // for each output channel
+
+    // the new pin settings do not match what was last written
+    ForceOutputUpdate = true;
+
+    // DEBUG_END;
+
+} // ConfigureOutputs
+
 //----------------------------------------------------------------------------
 /* Process the config
 *
@@ -221,6 +360,9 @@ bool c_OutputRelay::SetConfig (ArduinoJson::JsonObject & jsonConfig)
 
         // PrettyPrint (jsonConfig, String("c_OutputRelay::SetConfig"));
         setFromJSON (UpdateInterval, jsonConfig, OM_RELAY_UPDATE_INTERVAL_NAME);
+#if defined(ARDUINO_ARCH_ESP32)
+        setFromJSON (PwmFadeTimeMs,  jsonConfig, CN_pwmfade);
+#endif // defined(ARDUINO_ARCH_ESP32)
 
         // do we have a channel configuration array?
         if (false == jsonConfig.containsKey (CN_channels))
@@ -300,6 +442,9 @@ void c_OutputRelay::GetConfig (ArduinoJson::JsonObject & jsonConfig)
     // DEBUG_START;
 
     jsonConfig[OM_RELAY_UPDATE_INTERVAL_NAME] = UpdateInterval;
+#if defined(ARDUINO_ARCH_ESP32)
+    jsonConfig[CN_pwmfade]                    = PwmFadeTimeMs;
+#endif // defined(ARDUINO_ARCH_ESP32)
 
     JsonArray JsonChannelList = jsonConfig.createNestedArray (CN_channels);
 
@@ -339,47 +484,130 @@ void  c_OutputRelay::GetDriverName (String & sDriverName)
 
 } // GetDriverName
 
+//----------------------------------------------------------------------------
+void c_OutputRelay::GetStatus (ArduinoJson::JsonObject & jsonStatus)
+{
+    // DEBUG_START;
+
+    c_OutputCommon::GetStatus (jsonStatus);
+
+    jsonStatus[F ("OutputWrites")] = OutputWrites;
+
+    // DEBUG_END;
+} // GetStatus
+
+//----------------------------------------------------------------------------
+/*
+*   Returns false if the channel is still fading toward its last value.
+*   The caller keeps the old value and tries again on the next render.
+*/
+bool c_OutputRelay::WritePwmValue (RelayChannel_t & currentRelay, uint8_t ChannelIndex, uint8_t NewValue)
+{
+    // DEBUG_START;
+    bool response = true;
+
+#if defined(ARDUINO_ARCH_ESP32)
+    do // once
+    {
+        if (!currentRelay.LedcAttached)
+        {
+            break;
+        }
+
+        // ledc_set_fade_with_time blocks until a running fade ends
+        if (currentRelay.FadeActive)
+        {
+            if ((millis () - currentRelay.FadeStartTimeMs) <= PwmFadeTimeMs)
+            {
+                response = false;
+                break;
+            }
+            currentRelay.FadeActive = false;
+        }
+
+        // at 8 bits a duty of 255 is still a short low pulse every period
+        uint32_t Duty = (RelayPwmHigh == NewValue) ? (1 << RelayLedcResolution) : NewValue;
+        ledc_channel_t Channel = ledc_channel_t (ChannelIndex);
+
+        if ((0 != PwmFadeTimeMs) && FadeFunctionInstalled && !ForceOutputUpdate)
+        {
+            ledc_set_fade_with_time (RelayLedcSpeedMode, Channel, Duty, PwmFadeTimeMs);
+            ledc_fade_start (RelayLedcSpeedMode, Channel, LEDC_FADE_NO_WAIT);
+            currentRelay.FadeActive      = true;
+            currentRelay.FadeStartTimeMs = millis ();
+        }
+        else
+        {
+            ledc_set_duty (RelayLedcSpeedMode, Channel, Duty);
+            ledc_update_duty (RelayLedcSpeedMode, Channel);
+        }
+        ++OutputWrites;
+
+    } while (false);
+#else
+    analogWrite (currentRelay.GpioId, NewValue);
+    ++OutputWrites;
+#endif // defined(ARDUINO_ARCH_ESP32)
+
+    // DEBUG_END;
+    return response;
+
+} // WritePwmValue
+
 //----------------------------------------------------------------------------
 void c_OutputRelay::Render ()
 {
     // DEBUG_START;
 
     uint8_t OutputDataIndex = 0;
+    LatchFrameBuffer ();
 
     for (RelayChannel_t & currentRelay : OutputList)
     {
         // DEBUG_V (String("OutputDataIndex: ") + String(OutputDataIndex));
         if (currentRelay.Enabled)
         {
-            uint8_t newOutputValue = map (pOutputBuffer[OutputDataIndex], 0, 255, currentRelay.OffValue, currentRelay.OnValue);
-            if (currentRelay.Pwm)
+            do // once
             {
-                #if defined(ARDUINO_ARCH_ESP32)
-                   ledcWrite(OutputDataIndex, newOutputValue);
-                #else
-                   analogWrite(currentRelay.GpioId, newOutputValue);
-                #endif
-            }
-            else
-            {
-                newOutputValue = (newOutputValue > currentRelay.OnOffTriggerLevel) ? currentRelay.OnValue : currentRelay.OffValue;
-                if (newOutputValue != currentRelay.previousValue)
+                uint8_t newOutputValue = map (pFrameBuffer[OutputDataIndex], 0, 255, currentRelay.OffValue, currentRelay.OnValue);
+                if (!currentRelay.Pwm)
+                {
+                    newOutputValue = (newOutputValue > currentRelay.OnOffTriggerLevel) ? currentRelay.OnValue : currentRelay.OffValue;
+                }
+
+                // only touch the hardware when the value changes
+                if ((newOutputValue == currentRelay.previousValue) && !ForceOutputUpdate)
+                {
+                    break;
+                }
+
+                if (currentRelay.Pwm)
+                {
+                    if (!WritePwmValue (currentRelay, OutputDataIndex, newOutputValue))
+                    {
+                        // still fading. Try again on the next render
+                        break;
+                    }
+                }
+                else
                 {
                     digitalWrite (currentRelay.GpioId, newOutputValue);
+                    ++OutputWrites;
                 }
-            }
 
-            // DEBUGV (String ("OutputDataIndex: ")       + String (OutputDataIndex++));
-            // DEBUGV (String ("currentRelay.OnValue: ")  + String (currentRelay.OnValue));
-            // DEBUGV (String ("currentRelay.OffValue: ") + String (currentRelay.OffValue));
-            // DEBUGV (String ("currentRelay.Enabled: ")  + String (currentRelay.Enabled));
-            // DEBUGV (String ("currentRelay.GpioId: ")   + String (currentRelay.GpioId));
-            // DEBUGV (String ("newOutputValue: ")        + String (newOutputValue));
-            // DEBUGV (String ("Pwm: ")                   + String (currentRelay.Pwm));
-            currentRelay.previousValue = newOutputValue;
+                // DEBUGV (String ("OutputDataIndex: ")       + String (OutputDataIndex++));
+                // DEBUGV (String ("currentRelay.OnValue: ")  + String (currentRelay.OnValue));
+                // DEBUGV (String ("currentRelay.OffValue: ") + String (currentRelay.OffValue));
+                // DEBUGV (String ("currentRelay.Enabled: ")  + String (currentRelay.Enabled));
+                // DEBUGV (String ("currentRelay.GpioId: ")   + String (currentRelay.GpioId));
+                // DEBUGV (String ("newOutputValue: ")        + String (newOutputValue));
+                // DEBUGV (String ("Pwm: ")                   + String (currentRelay.Pwm));
+                currentRelay.previousValue = newOutputValue;
+            } while (false);
         }
         ++OutputDataIndex;
     }
+    ForceOutputUpdate = false;
     ReportNewFrame ();
 
     // DEBUG_END;
@@ -48,6 +48,9 @@ public:
         uint8_t     previousValue;
 #if defined(ARDUINO_ARCH_ESP32)
         uint16_t    PwmFrequency;
+        bool        LedcAttached;       ///< GPIO is driven by the LEDC channel with the same index
+        bool        FadeActive;
+        uint32_t    FadeStartTimeMs;
 #endif // defined(ARDUINO_ARCH_ESP32)
 
     } RelayChannel_t;
@@ -65,7 +68,7 @@ public:
     void   GetConfig (ArduinoJson::JsonObject & jsonConfig); ///< Get the current config used by the driver
     void   Render ();                                        ///< Call from loop(),  renders output data
     void   GetDriverName (String& sDriverName);
-    void   GetStatus (ArduinoJson::JsonObject & jsonStatus) { c_OutputCommon::GetStatus (jsonStatus); }
+    void   GetStatus (ArduinoJson::JsonObject & jsonStatus);
     size_t GetNumChannelsNeeded () { return Num_Channels; }
 
 
@@ -75,16 +78,28 @@ private:
 #   define OM_RELAY_CHANNEL_ENABLED_NAME    CN_en
 #   define OM_RELAY_CHANNEL_INVERT_NAME     CN_inv
 #   define OM_RELAY_CHANNEL_PWM_NAME        CN_pwm
+#   define OM_RELAY_PWM_MAX_FADE_MS         1000
 
     bool    validate ();
+    void    ConfigureOutputs ();
+    bool    WritePwmValue (RelayChannel_t & currentRelay, uint8_t ChannelIndex, uint8_t NewValue);
 
     // config data
     RelayChannel_t  OutputList[OM_RELAY_CHANNEL_LIMIT];
     uint16_t        UpdateInterval = 0;
+#if defined(ARDUINO_ARCH_ESP32)
+    uint16_t        PwmFadeTimeMs  = 0; ///< 0 = jump straight to each new duty value
+#endif // defined(ARDUINO_ARCH_ESP32)
 
     // non config data
     String      OutputName;
     uint16_t    Num_Channels = OM_RELAY_CHANNEL_LIMIT;
+    bool        ForceOutputUpdate = true;
+    uint32_t    OutputWrites = 0;
+#if defined(ARDUINO_ARCH_ESP32)
+    bool        FadeFunctionInstalled = false;
+    bool        OwnsFadeFunction = false;      ///< We installed the fade service and must remove it
+#endif // defined(ARDUINO_ARCH_ESP32)
 
 }; // c_OutputRelay
 
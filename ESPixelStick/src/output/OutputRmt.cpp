@@ -24,12 +24,23 @@
 // forward declaration for the isr handler
 static void IRAM_ATTR rmt_intr_handler (void* param);
 
+c_OutputRmt * c_OutputRmt::ArmedChannels[RMT_CHANNEL_MAX];
+size_t        c_OutputRmt::NumArmedChannels        = 0;
+uint32_t      c_OutputRmt::LastNumChannelsStarted  = 0;
+uint32_t      c_OutputRmt::LastStartSpreadInCycles = 0;
+uint32_t      c_OutputRmt::MaxStartSpreadInCycles  = 0;
+uint8_t       c_OutputRmt::MemBlocksPerChannel[RMT_CHANNEL_MAX];
+uint8_t       c_OutputRmt::ActiveMemBlocks[RMT_CHANNEL_MAX];
+
+static portMUX_TYPE RmtStartLock = portMUX_INITIALIZER_UNLOCKED;
+
 //----------------------------------------------------------------------------
 c_OutputRmt::c_OutputRmt()
 {
     // DEBUG_START;
 
     memset((void *)&Intensity2Rmt[0],   0x00, sizeof(Intensity2Rmt));
+    memset((void *)&Nibble2Rmt[0][0],   0x00, sizeof(Nibble2Rmt));
 #ifdef USE_RMT_DEBUG_COUNTERS
     memset((void *)&BitTypeCounters[0], 0x00, sizeof(BitTypeCounters));
 #endif // def USE_RMT_DEBUG_COUNTERS
@@ -59,10 +70,13 @@ c_OutputRmt::~c_OutputRmt ()
         RMT.conf_ch[OutputRmtConfig.RmtChannelId].conf1.mem_rd_rst = 0;
 
         rmt_isr_deregister (RMT_intr_handle);
+        ActiveMemBlocks[OutputRmtConfig.RmtChannelId] = 0;
 
         EnableInterrupts;
     }
 
+    FreePreEncodedFrame ();
+
     // DEBUG_END;
 } // ~c_OutputRmt
 
@@ -99,21 +113,43 @@ void c_OutputRmt::Begin (OutputRmtConfig_t config )
             break;
         }
 
+        if (nullptr != OutputRmtConfig.pPixelDataSource)
+        {
+            pTelemetry = &OutputRmtConfig.pPixelDataSource->GetTelemetry ();
+        }
+#if defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
+        else
+        {
+            pTelemetry = &OutputRmtConfig.pSerialDataSource->GetTelemetry ();
+        }
+#endif // defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
+
         NumRmtSlotsPerIntensityValue = OutputRmtConfig.IntensityDataWidth + ((OutputRmtConfig.SendInterIntensityBits) ? 1 : 0);
         TxIntensityDataStartingMask  = 1 << (OutputRmtConfig.IntensityDataWidth - 1);
+        UseNibble2Rmt                = (0 == (OutputRmtConfig.IntensityDataWidth & 0x3));
         // DEBUG_V (String("          IntensityDataWidth: ") + String(OutputRmtConfig.IntensityDataWidth));
         // DEBUG_V (String("NumRmtSlotsPerIntensityValue: ") + String (NumRmtSlotsPerIntensityValue));
         // DEBUG_V(String("  TxIntensityDataStartingMask: 0x") + String(TxIntensityDataStartingMask, HEX));
         // DEBUG_V (String ("                    DataPin: ") + String (OutputRmtConfig.DataPin));
         // DEBUG_V (String ("               RmtChannelId: ") + String (OutputRmtConfig.RmtChannelId));
 
+        // use the memory the output manager set aside for this channel
+        NumMemBlocks            = max (uint8_t (1), MemBlocksPerChannel[OutputRmtConfig.RmtChannelId]);
+        NumRmtSlots             = NUM_RMT_SLOTS * NumMemBlocks;
+        MaxRmtSlotsPerInterrupt = NumRmtSlots * 0.75;
+        MinRmtSlotsPerInterrupt = NumRmtSlots / 4;
+        NumRmtSlotsPerInterrupt = MaxRmtSlotsPerInterrupt;
+        UnderrunMarginInSlots   = (NumRmtSlots - MaxRmtSlotsPerInterrupt) / 2;
+        ActiveMemBlocks[OutputRmtConfig.RmtChannelId] = NumMemBlocks;
+        // DEBUG_V (String ("NumMemBlocks: ") + String (NumMemBlocks));
+
         // Configure RMT channel
         rmt_config_t RmtConfig;
         RmtConfig.rmt_mode = rmt_mode_t::RMT_MODE_TX;
         RmtConfig.channel = OutputRmtConfig.RmtChannelId;
         RmtConfig.clk_div = RMT_Clock_Divisor;
         RmtConfig.gpio_num = OutputRmtConfig.DataPin;
-        RmtConfig.mem_block_num = rmt_reserve_memsize_t::RMT_MEM_64;
+        RmtConfig.mem_block_num = NumMemBlocks;
 
         RmtConfig.tx_config.loop_en = false;
         RmtConfig.tx_config.carrier_freq_hz = uint32_t(100); // cannot be zero due to a driver bug
@@ -140,13 +176,14 @@ void c_OutputRmt::Begin (OutputRmtConfig_t config )
         RMT.conf_ch[OutputRmtConfig.RmtChannelId].conf1.mem_rd_rst = 0;
         // DEBUG_V();
 
+        // the blocks of the following channels are contiguous with ours
         RmtStartAddr = &RMTMEM.chan[OutputRmtConfig.RmtChannelId].data32[0];
-        RmtEndAddr = &RMTMEM.chan[OutputRmtConfig.RmtChannelId].data32[63];
+        RmtEndAddr = RmtStartAddr + (NumRmtSlots - 1);
         RmtCurrentAddr = RmtStartAddr;
         // DEBUG_V();
 
         RMT.tx_lim_ch[OutputRmtConfig.RmtChannelId].limit = NumRmtSlotsPerInterrupt;
-        NumAvailableRmtSlotsToFill = NUM_RMT_SLOTS;
+        NumAvailableRmtSlotsToFill = NumRmtSlots;
         // DEBUG_V();
 
         // this should be a vector but Arduino does not support them.
@@ -163,7 +200,7 @@ void c_OutputRmt::Begin (OutputRmtConfig_t config )
         }
 
         // create a delay before starting to send data
-        LastFrameStartTime = millis();
+        LastFrameStartTime = OutputMgr.GetFrameClockInMicroSec ();
 
         // DEBUG_V (String ("                Intensity2Rmt[0]: 0x") + String (uint32_t (Intensity2Rmt[0].val), HEX));
         // DEBUG_V (String ("                Intensity2Rmt[1]: 0x") + String (uint32_t (Intensity2Rmt[1].val), HEX));
@@ -185,6 +222,7 @@ void IRAM_ATTR c_OutputRmt::ISR_Handler ()
 {
     // //DEBUG_START;
 
+    uint32_t IsrStartCycle = c_OutputTelemetry::GetCycleCount ();
     uint32_t int_st = RMT.int_raw.val;
     // //DEBUG_V(String("              int_st: 0x") + String(int_st, HEX));
     // //DEBUG_V(String("  RMT_INT_TX_END_BIT: 0x") + String(RMT_INT_TX_END_BIT, HEX));
@@ -205,6 +243,17 @@ void IRAM_ATTR c_OutputRmt::ISR_Handler ()
             RMT.int_clr.val = RMT_INT_TX_END_BIT;
             RMT.int_clr.val = RMT_INT_THR_EVNT_BIT;
 
+            ++NumInterrupts;
+            pTelemetry->WireDone ();
+            if (MoreDataToSend ())
+            {
+                // the transmitter reached the end marker before the refill got to it
+                ++pTelemetry->IncompleteFrames;
+                ++NumUnderruns;
+                RefillWasLate   = true;
+                RetransmitFrame = true;
+            }
+
             // ISR_Handler_StartNewFrame ();
             break;
         }
@@ -220,14 +269,30 @@ void IRAM_ATTR c_OutputRmt::ISR_Handler ()
             // RMT.int_ena.val &= ~RMT_INT_THR_EVNT (OutputRmtConfig.RmtChannelId);
             RMT.int_clr.val = RMT_INT_THR_EVNT_BIT;
 
+            ++NumInterrupts;
             NumAvailableRmtSlotsToFill += NumRmtSlotsPerInterrupt;
-            if (NUM_RMT_SLOTS < NumAvailableRmtSlotsToFill)
+            if (NumRmtSlots < NumAvailableRmtSlotsToFill)
             {
-                NumAvailableRmtSlotsToFill = NUM_RMT_SLOTS;
+                // more slots were freed than the buffer holds. A threshold event was missed
+                if (MoreDataToSend ())
+                {
+                    ++pTelemetry->Overruns;
+                    RefillWasLate = true;
+                }
+                NumAvailableRmtSlotsToFill = NumRmtSlots;
             }
 
             if (MoreDataToSend())
             {
+                // how far ahead of the transmitter the data in the buffer still reaches
+                size_t WriteIndex      = size_t (RmtCurrentAddr - RmtStartAddr);
+                size_t NumSlotsPending = (WriteIndex + NumRmtSlots - GetRmtReadIndex ()) % NumRmtSlots;
+                if (NumSlotsPending < UnderrunMarginInSlots)
+                {
+                    ++NumNearUnderruns;
+                    RefillWasLate = true;
+                }
+
                 EnableInterrupts;
                 ISR_Handler_SendIntensityData();
             }
@@ -256,6 +321,11 @@ void IRAM_ATTR c_OutputRmt::ISR_Handler ()
 #endif // def USE_RMT_DEBUG_COUNTERS
     } while (false);
 
+    if (int_st & (RMT_INT_TX_END_BIT | RMT_INT_THR_EVNT_BIT))
+    {
+        pTelemetry->AddIsrCycles (c_OutputTelemetry::GetCycleCount () - IsrStartCycle);
+    }
+
     // //DEBUG_END;
 
 } // ISR_Handler
@@ -303,10 +373,80 @@ inline void IRAM_ATTR c_OutputRmt::ISR_EnqueueData(uint32_t value)
     // //DEBUG_END;
 }
 
+//----------------------------------------------------------------------------
+inline void IRAM_ATTR c_OutputRmt::ISR_EnqueueNibble(const uint32_t * pItems)
+{
+    if (3 <= (RmtEndAddr - RmtCurrentAddr))
+    {
+        // all four items fit before the wrap point
+        RmtCurrentAddr[0].val = pItems[0];
+        RmtCurrentAddr[1].val = pItems[1];
+        RmtCurrentAddr[2].val = pItems[2];
+        RmtCurrentAddr[3].val = pItems[3];
+
+        NumAvailableRmtSlotsToFill -= 4;
+
+        RmtCurrentAddr += 4;
+        if (RmtCurrentAddr > RmtEndAddr)
+        {
+            RmtCurrentAddr = RmtStartAddr;
+        }
+    }
+    else
+    {
+        ISR_EnqueueData (pItems[0]);
+        ISR_EnqueueData (pItems[1]);
+        ISR_EnqueueData (pItems[2]);
+        ISR_EnqueueData (pItems[3]);
+    }
+} // ISR_EnqueueNibble
+
+//----------------------------------------------------------------------------
+// Copy as much of the pre encoded frame as fits. Leaves room for the terminator
+inline void IRAM_ATTR c_OutputRmt::ISR_CopyPreEncodedData()
+{
+    size_t NumItemsToCopy = (NumAvailableRmtSlotsToFill > 1) ? min (size_t (NumPreEncodedItemsToSend), size_t (NumAvailableRmtSlotsToFill - 1)) : 0;
+    NumPreEncodedItemsToSend   -= NumItemsToCopy;
+    NumAvailableRmtSlotsToFill -= NumItemsToCopy;
+
+    while (0 != NumItemsToCopy)
+    {
+        size_t NumItemsBeforeWrap = size_t (RmtEndAddr - RmtCurrentAddr) + 1;
+        size_t NumItemsThisPass   = min (NumItemsToCopy, NumItemsBeforeWrap);
+        NumItemsToCopy -= NumItemsThisPass;
+
+        while (0 != NumItemsThisPass--)
+        {
+            (RmtCurrentAddr++)->val = (pNextPreEncodedItem++)->val;
+        }
+
+        if (RmtCurrentAddr > RmtEndAddr)
+        {
+            RmtCurrentAddr = RmtStartAddr;
+        }
+    }
+} // ISR_CopyPreEncodedData
+
+//----------------------------------------------------------------------------
+// Slot the transmitter reads next, relative to the start of this channel's memory
+inline size_t IRAM_ATTR c_OutputRmt::GetRmtReadIndex()
+{
+    uint32_t Status   = REG_READ (RMT_CH0STATUS_REG + (4 * uint32_t (OutputRmtConfig.RmtChannelId)));
+    size_t   ReadAddr = (Status >> RMT_MEM_RADDR_EX_CH0_S) & RMT_MEM_RADDR_EX_CH0;
+    size_t   BaseAddr = NUM_RMT_SLOTS * size_t (OutputRmtConfig.RmtChannelId);
+
+    return (ReadAddr < BaseAddr) ? 0 : ((ReadAddr - BaseAddr) % NumRmtSlots);
+
+} // GetRmtReadIndex
+
 //----------------------------------------------------------------------------
 inline bool IRAM_ATTR c_OutputRmt::MoreDataToSend()
 {
-    if (nullptr != OutputRmtConfig.pPixelDataSource)
+    if (0 != NumPreEncodedItemsToSend)
+    {
+        return true;
+    }
+    else if (nullptr != OutputRmtConfig.pPixelDataSource)
     {
         return OutputRmtConfig.pPixelDataSource->ISR_MoreDataToSend();
     }
@@ -321,21 +461,21 @@ inline bool IRAM_ATTR c_OutputRmt::MoreDataToSend()
 }
 
 //----------------------------------------------------------------------------
-inline uint32_t IRAM_ATTR c_OutputRmt::GetNextIntensityToSend()
+inline size_t IRAM_ATTR c_OutputRmt::GetNextIntensityBlock(uint32_t * pTarget, size_t MaxIntensities)
 {
     if (nullptr != OutputRmtConfig.pPixelDataSource)
     {
-        return OutputRmtConfig.pPixelDataSource->ISR_GetNextIntensityToSend();
+        return OutputRmtConfig.pPixelDataSource->ISR_EncodeBlock(pTarget, MaxIntensities);
     }
 #if defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
     else
     {
-        return OutputRmtConfig.pSerialDataSource->ISR_GetNextIntensityToSend();
+        return OutputRmtConfig.pSerialDataSource->ISR_EncodeBlock(pTarget, MaxIntensities);
     }
 #else
-    return false;
+    return 0;
 #endif // defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
-} // GetNextIntensityToSend
+} // GetNextIntensityBlock
 
 //----------------------------------------------------------------------------
 inline void IRAM_ATTR c_OutputRmt::StartNewDataFrame()
@@ -415,47 +555,78 @@ void IRAM_ATTR c_OutputRmt::ISR_Handler_SendIntensityData ()
 
     uint32_t OneBitValue  = Intensity2Rmt[RmtDataBitIdType_t::RMT_DATA_BIT_ONE_ID].val;
     uint32_t ZeroBitValue = Intensity2Rmt[RmtDataBitIdType_t::RMT_DATA_BIT_ZERO_ID].val;
+    uint32_t IntensityBlock[RMT_INTENSITY_BLOCK_SIZE];
 
-    while ((NumAvailableRmtSlotsToFill > NumRmtSlotsPerIntensityValue) && MoreDataToSend())
+    if (0 != NumPreEncodedItemsToSend)
     {
-        uint32_t IntensityValue = GetNextIntensityToSend();
-#ifdef USE_RMT_DEBUG_COUNTERS
-        IntensityValuesSent++;
-#endif // def USE_RMT_DEBUG_COUNTERS
+        ISR_CopyPreEncodedData ();
+    }
 
-        // convert the intensity data into RMT slot data
-        for (uint32_t bitmask = TxIntensityDataStartingMask; 0 != bitmask; bitmask >>= 1)
+    // a frame that did not fit in the pre encoded buffer is finished here
+    while ((0 == NumPreEncodedItemsToSend) && (NumAvailableRmtSlotsToFill > NumRmtSlotsPerIntensityValue) && MoreDataToSend())
+    {
+        // get as many intensity values as will fit in the free slots in one call
+        size_t NumIntensitiesToGet = min(size_t((NumAvailableRmtSlotsToFill - 1) / NumRmtSlotsPerIntensityValue), size_t(RMT_INTENSITY_BLOCK_SIZE));
+        size_t NumIntensities      = GetNextIntensityBlock(IntensityBlock, NumIntensitiesToGet);
+        bool   FrameIsComplete     = !MoreDataToSend();
+
+        for (size_t IntensityIndex = 0; IntensityIndex < NumIntensities; ++IntensityIndex)
         {
+            uint32_t IntensityValue = IntensityBlock[IntensityIndex];
 #ifdef USE_RMT_DEBUG_COUNTERS
-            IntensityBitsSent++;
+            IntensityValuesSent++;
 #endif // def USE_RMT_DEBUG_COUNTERS
-            ISR_EnqueueData((IntensityValue & bitmask) ? OneBitValue : ZeroBitValue);
-#ifdef USE_RMT_DEBUG_COUNTERS
-            if (IntensityValue & bitmask)
+
+            // convert the intensity data into RMT slot data
+            if (UseNibble2Rmt)
             {
-                BitTypeCounters[int(RmtDataBitIdType_t::RMT_DATA_BIT_ONE_ID)]++;
+                for (int32_t Shift = int32_t(OutputRmtConfig.IntensityDataWidth) - 4; 0 <= Shift; Shift -= 4)
+                {
+                    uint32_t Nibble = (IntensityValue >> Shift) & 0x0F;
+                    ISR_EnqueueNibble (Nibble2Rmt[Nibble]);
+#ifdef USE_RMT_DEBUG_COUNTERS
+                    IntensityBitsSent += 4;
+                    BitTypeCounters[int(RmtDataBitIdType_t::RMT_DATA_BIT_ONE_ID)]  += __builtin_popcount(Nibble);
+                    BitTypeCounters[int(RmtDataBitIdType_t::RMT_DATA_BIT_ZERO_ID)] += 4 - __builtin_popcount(Nibble);
+#endif // def USE_RMT_DEBUG_COUNTERS
+                }
             }
             else
             {
-                BitTypeCounters[int(RmtDataBitIdType_t::RMT_DATA_BIT_ZERO_ID)]++;
-            }
+                for (uint32_t bitmask = TxIntensityDataStartingMask; 0 != bitmask; bitmask >>= 1)
+                {
+#ifdef USE_RMT_DEBUG_COUNTERS
+                    IntensityBitsSent++;
+#endif // def USE_RMT_DEBUG_COUNTERS
+                    ISR_EnqueueData((IntensityValue & bitmask) ? OneBitValue : ZeroBitValue);
+#ifdef USE_RMT_DEBUG_COUNTERS
+                    if (IntensityValue & bitmask)
+                    {
+                        BitTypeCounters[int(RmtDataBitIdType_t::RMT_DATA_BIT_ONE_ID)]++;
+                    }
+                    else
+                    {
+                        BitTypeCounters[int(RmtDataBitIdType_t::RMT_DATA_BIT_ZERO_ID)]++;
+                    }
 #endif // def USE_RMT_DEBUG_COUNTERS
-        } // end send one intensity value
+                } // end send one intensity value
+            }
 
-        if (OutputRmtConfig.SendEndOfFrameBits && !MoreDataToSend())
-        {
-            ISR_EnqueueData(Intensity2Rmt[RmtDataBitIdType_t::RMT_END_OF_FRAME].val);
+            if (OutputRmtConfig.SendEndOfFrameBits && FrameIsComplete && (IntensityIndex == (NumIntensities - 1)))
+            {
+                ISR_EnqueueData(Intensity2Rmt[RmtDataBitIdType_t::RMT_END_OF_FRAME].val);
 #ifdef USE_RMT_DEBUG_COUNTERS
-            BitTypeCounters[int(RmtDataBitIdType_t::RMT_END_OF_FRAME)]++;
+                BitTypeCounters[int(RmtDataBitIdType_t::RMT_END_OF_FRAME)]++;
 #endif // def USE_RMT_DEBUG_COUNTERS
-        }
-        else if (OutputRmtConfig.SendInterIntensityBits)
-        {
-            ISR_EnqueueData(Intensity2Rmt[RmtDataBitIdType_t::RMT_STOP_START_BIT_ID].val);
+            }
+            else if (OutputRmtConfig.SendInterIntensityBits)
+            {
+                ISR_EnqueueData(Intensity2Rmt[RmtDataBitIdType_t::RMT_STOP_START_BIT_ID].val);
 #ifdef USE_RMT_DEBUG_COUNTERS
-            BitTypeCounters[int(RmtDataBitIdType_t::RMT_STOP_START_BIT_ID)]++;
+                BitTypeCounters[int(RmtDataBitIdType_t::RMT_STOP_START_BIT_ID)]++;
 #endif // def USE_RMT_DEBUG_COUNTERS
-        }
+            }
+        } // end for each intensity in the block
     } // end while there is space in the buffer
 
     // terminate the current data in the buffer
@@ -466,6 +637,38 @@ void IRAM_ATTR c_OutputRmt::ISR_Handler_SendIntensityData ()
 
 } // ISR_Handler_SendIntensityData
 
+//----------------------------------------------------------------------------
+void c_OutputRmt::SetIntensity2Rmt (rmt_item32_t NewValue, RmtDataBitIdType_t ID)
+{
+    Intensity2Rmt[ID] = NewValue;
+
+    if ((RmtDataBitIdType_t::RMT_DATA_BIT_ZERO_ID == ID) || (RmtDataBitIdType_t::RMT_DATA_BIT_ONE_ID == ID))
+    {
+        UpdateNibble2Rmt ();
+    }
+
+} // SetIntensity2Rmt
+
+//----------------------------------------------------------------------------
+// Expand the one and zero bit items into a table indexed by four data bits
+void c_OutputRmt::UpdateNibble2Rmt ()
+{
+    // DEBUG_START;
+
+    uint32_t OneBitValue  = Intensity2Rmt[RmtDataBitIdType_t::RMT_DATA_BIT_ONE_ID].val;
+    uint32_t ZeroBitValue = Intensity2Rmt[RmtDataBitIdType_t::RMT_DATA_BIT_ZERO_ID].val;
+
+    for (uint32_t Nibble = 0; Nibble < 16; ++Nibble)
+    {
+        for (uint32_t BitIndex = 0; BitIndex < 4; ++BitIndex)
+        {
+            Nibble2Rmt[Nibble][BitIndex] = (Nibble & (0x08 >> BitIndex)) ? OneBitValue : ZeroBitValue;
+        }
+    }
+
+    // DEBUG_END;
+} // UpdateNibble2Rmt
+
 //----------------------------------------------------------------------------
 bool c_OutputRmt::Render ()
 {
@@ -484,7 +687,13 @@ bool c_OutputRmt::Render ()
             break;
         }
 
-        if ((millis() - LastFrameStartTime) < MIN_FRAME_TIME_MS)
+        if (RetransmitFrame)
+        {
+            // the last frame was cut short. The idle bits at the start of the frame provide the reset gap
+            RetransmitFrame = false;
+            ++NumRetransmits;
+        }
+        else if ((OutputMgr.GetFrameClockInMicroSec () - LastFrameStartTime) < FrameMinDurationInMicroSec)
         {
             break;
         }
@@ -507,17 +716,38 @@ bool c_OutputRmt::Render ()
         RMT.conf_ch[OutputRmtConfig.RmtChannelId].conf1.mem_rd_rst = 1;
         RMT.conf_ch[OutputRmtConfig.RmtChannelId].conf1.mem_rd_rst = 0;
         RmtCurrentAddr = RmtStartAddr;
-        NumAvailableRmtSlotsToFill = NUM_RMT_SLOTS;
+        NumAvailableRmtSlotsToFill = NumRmtSlots;
+        AdjustWatermark ();
         RMT.tx_lim_ch[OutputRmtConfig.RmtChannelId].limit = NumRmtSlotsPerInterrupt;
 
         // //DEBUG_V("Set up a new Frame");
-        StartNewFrame();
+        NumPreEncodedItemsToSend = 0;
+        if (OutputMgr.GetRmtPreEncode () && AllocatePreEncodedFrame ())
+        {
+            PreEncodeFrame ();
+        }
+        else
+        {
+            if (OutputMgr.GetRmtPreEncode ())
+            {
+                ++PreEncodeFallbacks;
+            }
+            FreePreEncodedFrame ();
+            StartNewFrame ();
+        }
 
-        // //DEBUG_V("Start Transmit");
-        // enable the threshold event interrupt
-        EnableInterrupts;
-        RMT.conf_ch[OutputRmtConfig.RmtChannelId].conf1.tx_start = 1;
-        LastFrameStartTime = millis ();
+        if ((c_OutputMgr::RmtStartMode_t::RmtStartIndependent == OutputMgr.GetRmtStartMode ()) ||
+            (NumArmedChannels >= RMT_CHANNEL_MAX))
+        {
+            // //DEBUG_V("Start Transmit");
+            StartTransmit ();
+        }
+        else
+        {
+            // the output manager starts all of the armed channels once every output has rendered
+            ArmedChannels[NumArmedChannels++] = this;
+        }
+        LastFrameStartTime = OutputMgr.GetFrameClockInMicroSec ();
         // //DEBUG_V("Transmit Started");
         Response = true;
 
@@ -529,12 +759,352 @@ bool c_OutputRmt::Render ()
 
 } // render
 
+//----------------------------------------------------------------------------
+/*
+    Make sure the pre encoded frame buffer can hold a whole frame. Returns
+    false if pre encoding cannot be used for this channel. Frames larger than
+    RMT_PRE_ENCODE_MAX_SLOTS are always encoded in the ISR.
+*/
+bool c_OutputRmt::AllocatePreEncodedFrame ()
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do // once
+    {
+        size_t NumIntensities = 0;
+        if (nullptr != OutputRmtConfig.pPixelDataSource)
+        {
+            NumIntensities = OutputRmtConfig.pPixelDataSource->GetNumChannelsNeeded ();
+        }
+#if defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
+        else
+        {
+            NumIntensities = OutputRmtConfig.pSerialDataSource->GetNumChannelsNeeded ();
+        }
+#endif // defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
+
+        // frame start and end bits, the terminator and one block of slack
+        size_t NumItemsNeeded = OutputRmtConfig.NumIdleBits + OutputRmtConfig.NumFrameStartBits + 2 +
+                                ((NumIntensities + RMT_INTENSITY_BLOCK_SIZE) * NumRmtSlotsPerIntensityValue);
+        NumItemsNeeded = max (NumItemsNeeded, PreEncodedFrameMinSize);
+
+        if (NumItemsNeeded > RMT_PRE_ENCODE_MAX_SLOTS)
+        {
+            if (!PreEncodeTooBig)
+            {
+                logcon (String (F ("RMT ")) + String (OutputRmtConfig.RmtChannelId) + String (F (": Frame needs ")) + String (NumItemsNeeded) + String (F (" slots. Pre encoding is limited to ")) + String (RMT_PRE_ENCODE_MAX_SLOTS) + String (F (". Encoding in the ISR")));
+                PreEncodeTooBig = true;
+            }
+            break;
+        }
+        PreEncodeTooBig = false;
+
+        if (NumItemsNeeded <= PreEncodedFrameSize)
+        {
+            Response = true;
+            break;
+        }
+
+        if (NumItemsNeeded == PreEncodeFailedSize)
+        {
+            // already tried and failed. Stay with the ISR encoder
+            break;
+        }
+
+        FreePreEncodedFrame ();
+        PreEncodedFrame = (rmt_item32_t *)heap_caps_malloc (NumItemsNeeded * sizeof (rmt_item32_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_32BIT);
+        if (nullptr == PreEncodedFrame)
+        {
+            logcon (String (F ("RMT ")) + String (OutputRmtConfig.RmtChannelId) + String (F (": Not enough memory to pre encode ")) + String (NumItemsNeeded) + String (F (" slots. Encoding in the ISR")));
+            PreEncodeFailedSize = NumItemsNeeded;
+            break;
+        }
+
+        PreEncodedFrameSize = NumItemsNeeded;
+        PreEncodeFailedSize = 0;
+        // DEBUG_V (String ("PreEncodedFrameSize: ") + String (PreEncodedFrameSize));
+        Response = true;
+
+    } while (false);
+
+    // DEBUG_END;
+
+    return Response;
+
+} // AllocatePreEncodedFrame
+
+//----------------------------------------------------------------------------
+void c_OutputRmt::FreePreEncodedFrame ()
+{
+    // DEBUG_START;
+
+    if (nullptr != PreEncodedFrame)
+    {
+        NumPreEncodedItemsToSend = 0;
+        free (PreEncodedFrame);
+        PreEncodedFrame     = nullptr;
+        PreEncodedFrameSize = 0;
+    }
+
+    // DEBUG_END;
+} // FreePreEncodedFrame
+
+//----------------------------------------------------------------------------
+/*
+    Run the normal frame encoder with the ring pointed at the frame buffer
+    instead of RMTMEM, then prime RMTMEM from the result. Called with the
+    channel interrupts disabled.
+*/
+void c_OutputRmt::PreEncodeFrame ()
+{
+    // DEBUG_START;
+
+    volatile rmt_item32_t * RmtMemStartAddr = RmtStartAddr;
+    volatile rmt_item32_t * RmtMemEndAddr   = RmtEndAddr;
+
+    RmtStartAddr               = PreEncodedFrame;
+    RmtEndAddr                 = PreEncodedFrame + (PreEncodedFrameSize - 1);
+    RmtCurrentAddr             = RmtStartAddr;
+    NumAvailableRmtSlotsToFill = PreEncodedFrameSize;
+
+    StartNewFrame ();
+
+    size_t NumItemsEncoded = size_t (RmtCurrentAddr - RmtStartAddr);
+    if (MoreDataToSend ())
+    {
+        // the rest of this frame gets encoded by the ISR. Make room for all of it next time
+        PreEncodedFrameMinSize = PreEncodedFrameSize * 2;
+        // DEBUG_V ("Pre encoded frame buffer is too small");
+    }
+
+    RmtStartAddr               = RmtMemStartAddr;
+    RmtEndAddr                 = RmtMemEndAddr;
+    RmtCurrentAddr             = RmtStartAddr;
+    NumAvailableRmtSlotsToFill = NumRmtSlots;
+
+    pNextPreEncodedItem        = PreEncodedFrame;
+    NumPreEncodedItemsToSend   = NumItemsEncoded;
+
+    ISR_Handler_SendIntensityData ();
+
+    // DEBUG_END;
+} // PreEncodeFrame
+
+//----------------------------------------------------------------------------
+void c_OutputRmt::StartTransmit ()
+{
+    pTelemetry->WireStart ();
+
+    // enable the threshold event interrupt
+    EnableInterrupts;
+    RMT.conf_ch[OutputRmtConfig.RmtChannelId].conf1.tx_start = 1;
+
+} // StartTransmit
+
+//----------------------------------------------------------------------------
+/*
+    Called between frames with the channel interrupts disabled. A late
+    refill lowers the threshold one step so the next refill starts with
+    more unsent slots in the buffer. After a run of clean frames the
+    threshold is raised again to cut the interrupt rate.
+*/
+void c_OutputRmt::AdjustWatermark ()
+{
+    // DEBUG_START;
+
+    size_t StepInSlots = max (size_t (1), NumRmtSlots / 8);
+
+    if (RefillWasLate)
+    {
+        RefillWasLate  = false;
+        NumCleanFrames = 0;
+        if (NumRmtSlotsPerInterrupt > MinRmtSlotsPerInterrupt)
+        {
+            NumRmtSlotsPerInterrupt = max (MinRmtSlotsPerInterrupt, NumRmtSlotsPerInterrupt - StepInSlots);
+            // DEBUG_V (String ("Lowered watermark: ") + String (NumRmtSlotsPerInterrupt));
+        }
+    }
+    else if (NumRmtSlotsPerInterrupt < MaxRmtSlotsPerInterrupt)
+    {
+        if (++NumCleanFrames >= RMT_WATERMARK_RECOVERY_FRAMES)
+        {
+            NumCleanFrames = 0;
+            NumRmtSlotsPerInterrupt = min (MaxRmtSlotsPerInterrupt, NumRmtSlotsPerInterrupt + StepInSlots);
+            // DEBUG_V (String ("Raised watermark: ") + String (NumRmtSlotsPerInterrupt));
+        }
+    }
+
+    // DEBUG_END;
+} // AdjustWatermark
+
+//----------------------------------------------------------------------------
+// Time it takes to send the slots between two threshold interrupts
+uint32_t c_OutputRmt::GetInterruptIntervalInNs ()
+{
+    rmt_item32_t & DataBit = Intensity2Rmt[RmtDataBitIdType_t::RMT_DATA_BIT_ZERO_ID];
+    float SlotTimeInNs = float (DataBit.duration0 + DataBit.duration1) * RMT_TickLengthNS;
+
+    return uint32_t (SlotTimeInNs * float (NumRmtSlotsPerInterrupt));
+
+} // GetInterruptIntervalInNs
+
+//----------------------------------------------------------------------------
+/*
+    Simultaneous: every armed channel is started in one critical section.
+    Staggered:    the starts are spread evenly over one threshold interrupt
+                  interval so the channel ISRs do not all fire together.
+*/
+void c_OutputRmt::StartArmedChannels (c_OutputMgr::RmtStartMode_t StartMode)
+{
+    // DEBUG_START;
+
+    do // once
+    {
+        if (0 == NumArmedChannels)
+        {
+            break;
+        }
+
+        uint32_t FirstStartCycle = 0;
+        uint32_t LastStartCycle  = 0;
+
+        if ((c_OutputMgr::RmtStartMode_t::RmtStartStaggered == StartMode) && (1 < NumArmedChannels))
+        {
+            uint32_t IntervalInNs = uint32_t (-1);
+            for (size_t ChannelIndex = 0; ChannelIndex < NumArmedChannels; ++ChannelIndex)
+            {
+                IntervalInNs = min (IntervalInNs, ArmedChannels[ChannelIndex]->GetInterruptIntervalInNs ());
+            }
+            uint32_t StepInCycles = ((IntervalInNs / NumArmedChannels) * ESP.getCpuFreqMHz ()) / NanoSecondsInAMicroSecond;
+
+            FirstStartCycle = ESP.getCycleCount ();
+            for (size_t ChannelIndex = 0; ChannelIndex < NumArmedChannels; ++ChannelIndex)
+            {
+                uint32_t TargetCycle = FirstStartCycle + (ChannelIndex * StepInCycles);
+                while (0 > int32_t (ESP.getCycleCount () - TargetCycle)) {}
+
+                portENTER_CRITICAL (&RmtStartLock);
+                ArmedChannels[ChannelIndex]->StartTransmit ();
+                LastStartCycle = ESP.getCycleCount ();
+                portEXIT_CRITICAL (&RmtStartLock);
+            }
+        }
+        else
+        {
+            portENTER_CRITICAL (&RmtStartLock);
+            FirstStartCycle = ESP.getCycleCount ();
+            for (size_t ChannelIndex = 0; ChannelIndex < NumArmedChannels; ++ChannelIndex)
+            {
+                ArmedChannels[ChannelIndex]->StartTransmit ();
+            }
+            LastStartCycle = ESP.getCycleCount ();
+            portEXIT_CRITICAL (&RmtStartLock);
+        }
+
+        LastNumChannelsStarted  = NumArmedChannels;
+        LastStartSpreadInCycles = LastStartCycle - FirstStartCycle;
+        MaxStartSpreadInCycles  = max (MaxStartSpreadInCycles, LastStartSpreadInCycles);
+        NumArmedChannels        = 0;
+
+    } while (false);
+
+    // DEBUG_END;
+} // StartArmedChannels
+
+//----------------------------------------------------------------------------
+void c_OutputRmt::GetStartStatus (ArduinoJson::JsonObject& jsonStatus)
+{
+    // DEBUG_START;
+
+    uint32_t CpuFreqMHz = ESP.getCpuFreqMHz ();
+    jsonStatus[F ("channels")]    = LastNumChannelsStarted;
+    jsonStatus[F ("spreadns")]    = (LastStartSpreadInCycles * NanoSecondsInAMicroSecond) / CpuFreqMHz;
+    jsonStatus[F ("maxspreadns")] = (MaxStartSpreadInCycles  * NanoSecondsInAMicroSecond) / CpuFreqMHz;
+    MaxStartSpreadInCycles = 0;
+
+    // DEBUG_END;
+} // GetStartStatus
+
+//----------------------------------------------------------------------------
+/*
+    A channel can use the memory blocks of the channels above it as long as
+    those channels are not transmitting. Each channel in use gets its own
+    block plus the blocks of the unused channels that follow it, up to
+    MaxBlocksPerChannel. The threshold interrupt then fires once per
+    0.75 * 64 * NumMemBlocks slots instead of once per 48.
+*/
+void c_OutputRmt::AllocateMemBlocks (const bool * ChannelIsInUse, uint8_t MaxBlocksPerChannel)
+{
+    // DEBUG_START;
+
+    MaxBlocksPerChannel = max (uint8_t (1), MaxBlocksPerChannel);
+
+    for (size_t ChannelIndex = 0; ChannelIndex < size_t (RMT_CHANNEL_MAX); ++ChannelIndex)
+    {
+        uint8_t NumBlocks = 0;
+        if (ChannelIsInUse[ChannelIndex])
+        {
+            NumBlocks = 1;
+            while ((NumBlocks < MaxBlocksPerChannel) &&
+                   ((ChannelIndex + NumBlocks) < size_t (RMT_CHANNEL_MAX)) &&
+                   !ChannelIsInUse[ChannelIndex + NumBlocks])
+            {
+                ++NumBlocks;
+            }
+        }
+        MemBlocksPerChannel[ChannelIndex] = NumBlocks;
+        // DEBUG_V (String ("Channel: ") + String (ChannelIndex) + String (" NumBlocks: ") + String (NumBlocks));
+
+        // a running channel cannot give up or take over memory without being restarted
+        if ((0 != ActiveMemBlocks[ChannelIndex]) && (0 != NumBlocks) && (ActiveMemBlocks[ChannelIndex] != NumBlocks))
+        {
+            logcon (String (F ("RMT memory allocation changed. Rebooting")));
+            reboot = true;
+        }
+    }
+
+    // DEBUG_END;
+} // AllocateMemBlocks
+
+//----------------------------------------------------------------------------
+void c_OutputRmt::GetMemStatus (ArduinoJson::JsonObject& jsonStatus)
+{
+    // DEBUG_START;
+
+    jsonStatus[F ("preencodemaxslots")] = RMT_PRE_ENCODE_MAX_SLOTS;
+
+    JsonArray BlocksStatus = jsonStatus.createNestedArray (F ("blocks"));
+    for (auto NumBlocks : ActiveMemBlocks)
+    {
+        BlocksStatus.add (NumBlocks);
+    }
+
+    // DEBUG_END;
+} // GetMemStatus
+
 //----------------------------------------------------------------------------
 void c_OutputRmt::GetStatus (ArduinoJson::JsonObject& jsonStatus)
 {
     // //DEBUG_START;
 
-    jsonStatus[F("NumRmtSlotOverruns")] = NumRmtSlotOverruns;
+    jsonStatus[F("NumRmtSlotOverruns")] = (nullptr == pTelemetry) ? 0 : pTelemetry->Overruns;
+    jsonStatus[F("MemBlocks")]          = NumMemBlocks;
+    jsonStatus[F("PreEncodedSlots")]    = PreEncodedFrameSize;
+    jsonStatus[F("PreEncodeFallbacks")] = PreEncodeFallbacks;
+    jsonStatus[F("Watermark")]          = NumRmtSlotsPerInterrupt;
+    jsonStatus[F("Underruns")]          = NumUnderruns;
+    jsonStatus[F("NearUnderruns")]      = NumNearUnderruns;
+    jsonStatus[F("Retransmits")]        = NumRetransmits;
+
+    // measured over the time since the last status request
+    uint32_t Now = millis ();
+    uint32_t CurrentNumInterrupts = NumInterrupts;
+    uint32_t ElapsedMs = Now - LastStatusTimeMs;
+    jsonStatus[F("InterruptsPerSec")]   = (0 == ElapsedMs) ? 0 : ((CurrentNumInterrupts - LastStatusNumInterrupts) * MilliSecondsInASecond) / ElapsedMs;
+    LastStatusNumInterrupts = CurrentNumInterrupts;
+    LastStatusTimeMs        = Now;
 #ifdef USE_RMT_DEBUG_COUNTERS
     JsonObject debugStatus = jsonStatus.createNestedObject("RMT Debug");
     debugStatus["RmtChannelId"]                 = OutputRmtConfig.RmtChannelId;
@@ -21,6 +21,7 @@
 #include "../ESPixelStick.h"
 #ifdef SUPPORT_RMT_OUTPUT
 #include <driver/rmt.h>
+#include <soc/rmt_reg.h>
 #include "OutputPixel.hpp"
 #include "OutputSerial.hpp"
 
@@ -83,10 +84,12 @@ private:
     OutputRmtConfig_t   OutputRmtConfig;
 
     rmt_item32_t        Intensity2Rmt[RmtDataBitIdType_t::RMT_LIST_END];
+    uint32_t            Nibble2Rmt[16][4];          ///< Four ready to store RMT items for each nibble value, MSB first
+    bool                UseNibble2Rmt = false;      ///< Data width is a multiple of four bits
     bool                OutputIsPaused   = false;
 
     uint32_t            NumRmtSlotsPerIntensityValue      = 8;
-    uint32_t            NumRmtSlotOverruns                = 0;
+    c_OutputTelemetry * pTelemetry                        = nullptr;   ///< Belongs to the data source
 
     rmt_isr_handle_t       RMT_intr_handle = NULL;
     volatile rmt_item32_t *RmtStartAddr    = nullptr;
@@ -94,20 +97,61 @@ private:
     volatile rmt_item32_t *RmtEndAddr      = nullptr;
 
 #define NUM_RMT_SLOTS (sizeof(RMTMEM.chan[0].data32) / sizeof(RMTMEM.chan[0].data32[0]))
-#define MIN_FRAME_TIME_MS 25
+#define RMT_INTENSITY_BLOCK_SIZE (NUM_RMT_SLOTS / 8)
 
+    size_t              NumMemBlocks                = 1;        ///< 64 slot blocks owned by this channel
+    size_t              NumRmtSlots                 = NUM_RMT_SLOTS;
     volatile size_t     NumAvailableRmtSlotsToFill  = NUM_RMT_SLOTS;
-    const size_t        NumRmtSlotsPerInterrupt     = NUM_RMT_SLOTS * 0.75;
-    uint32_t            LastFrameStartTime          = 0;
-    uint32_t            FrameMinDurationInMicroSec  = 1000;
+    size_t              NumRmtSlotsPerInterrupt     = NUM_RMT_SLOTS * 0.75;
+    volatile uint32_t   NumInterrupts               = 0;
+
+    // adaptive refill watermark. The threshold interrupt fires earlier when the refills run late
+#define RMT_WATERMARK_RECOVERY_FRAMES 256   // clean frames before the watermark is raised one step
+
+    size_t              MaxRmtSlotsPerInterrupt     = NUM_RMT_SLOTS * 0.75;
+    size_t              MinRmtSlotsPerInterrupt     = NUM_RMT_SLOTS / 4;
+    size_t              UnderrunMarginInSlots       = NUM_RMT_SLOTS / 8;   ///< Fewer unsent slots than this at a refill is a near underrun
+    uint32_t            NumCleanFrames              = 0;
+    volatile bool       RefillWasLate               = false;    ///< Set by the ISR. Acted on at the start of the next frame
+    volatile bool       RetransmitFrame             = false;    ///< The last frame was cut short. Resend without waiting for the frame timer
+    volatile uint32_t   NumUnderruns                = 0;        ///< Transmitter hit the end marker with data still pending
+    volatile uint32_t   NumNearUnderruns            = 0;
+    uint32_t            NumRetransmits              = 0;
+
+    // optional whole frame encoding done by the render task. The ISR only copies it into RMTMEM.
+    // Each slot is 4 bytes of internal RAM so this is only offered for short strings.
+#define RMT_PRE_ENCODE_MAX_SLOTS 2048   // 8 KB per output. 85 RGB pixels at 8 slots per intensity
+
+    rmt_item32_t      * PreEncodedFrame             = nullptr;  ///< Internal RAM. The ISR may run while PSRAM is unreachable
+    size_t              PreEncodedFrameSize         = 0;        ///< Allocated size in items
+    size_t              PreEncodedFrameMinSize      = 0;        ///< Grows when a frame did not fit
+    size_t              PreEncodeFailedSize         = 0;        ///< Size of the last allocation that failed
+    bool                PreEncodeTooBig             = false;    ///< Frame needs more than RMT_PRE_ENCODE_MAX_SLOTS
+    uint32_t            PreEncodeFallbacks          = 0;        ///< Frames encoded in the ISR while pre encoding was requested
+    volatile rmt_item32_t * pNextPreEncodedItem     = nullptr;
+    volatile size_t     NumPreEncodedItemsToSend    = 0;
+    uint32_t            LastStatusNumInterrupts     = 0;
+    uint32_t            LastStatusTimeMs            = 0;
+    uint32_t            LastFrameStartTime          = 0;        ///< frame clock at the start of the last frame
+    uint32_t            FrameMinDurationInMicroSec  = 25000;
     uint32_t            TxIntensityDataStartingMask = 0x80;
     RmtDataBitIdType_t  InterIntensityValueId       = RMT_INVALID_VALUE;
 
     void                  StartNewFrame ();
+    void                  StartTransmit ();
+    uint32_t              GetInterruptIntervalInNs ();
+    void                  AdjustWatermark ();
+    inline size_t   IRAM_ATTR GetRmtReadIndex();
     void            IRAM_ATTR ISR_Handler_SendIntensityData ();
     inline void     IRAM_ATTR ISR_EnqueueData(uint32_t value);
+    inline void     IRAM_ATTR ISR_EnqueueNibble(const uint32_t * pItems);
+    inline void     IRAM_ATTR ISR_CopyPreEncodedData();
+           bool               AllocatePreEncodedFrame ();
+           void               FreePreEncodedFrame ();
+           void               PreEncodeFrame ();
+           void               UpdateNibble2Rmt ();
     inline bool     IRAM_ATTR MoreDataToSend();
-    inline uint32_t IRAM_ATTR GetNextIntensityToSend();
+    inline size_t   IRAM_ATTR GetNextIntensityBlock(uint32_t * pTarget, size_t MaxIntensities);
     inline void     IRAM_ATTR StartNewDataFrame();
 
 #ifndef HasBeenInitialized
@@ -116,6 +160,17 @@ private:
 
     TaskHandle_t SendIntensityDataTaskHandle = NULL;
 
+    // channels that have their next frame loaded and are waiting for StartArmedChannels()
+    static c_OutputRmt * ArmedChannels[RMT_CHANNEL_MAX];
+    static size_t        NumArmedChannels;
+    static uint32_t      LastNumChannelsStarted;
+    static uint32_t      LastStartSpreadInCycles;    ///< Cycles between the first and last channel start
+    static uint32_t      MaxStartSpreadInCycles;
+
+    // memory blocks each hardware channel may use. Unused channels lend their blocks to the channel below them
+    static uint8_t       MemBlocksPerChannel[RMT_CHANNEL_MAX];
+    static uint8_t       ActiveMemBlocks[RMT_CHANNEL_MAX];       ///< What the running channels were started with
+
 public:
     c_OutputRmt ();
     virtual ~c_OutputRmt ();
@@ -129,6 +184,11 @@ public:
     inline uint32_t IRAM_ATTR GetRmtIntMask     ()               { return ((RMT_INT_TX_END_BIT | RMT_INT_ERROR_BIT | RMT_INT_ERROR_BIT | RMT_INT_THR_EVNT_BIT)); }
     void GetDriverName                          (String &value)  { value = CN_RMT; }
 
+    static void StartArmedChannels              (c_OutputMgr::RmtStartMode_t StartMode); ///< Start the channels that were armed during this render pass
+    static void GetStartStatus                  (ArduinoJson::JsonObject& jsonStatus);
+    static void AllocateMemBlocks               (const bool * ChannelIsInUse, uint8_t MaxBlocksPerChannel); ///< Call before the channels are started
+    static void GetMemStatus                    (ArduinoJson::JsonObject& jsonStatus);
+
 #define DisableInterrupts RMT.int_ena.val &= ~(RMT_INT_TX_END_BIT | RMT_INT_THR_EVNT_BIT)
 #define EnableInterrupts  RMT.int_ena.val |=  (RMT_INT_TX_END_BIT | RMT_INT_THR_EVNT_BIT)
 
@@ -136,7 +196,7 @@ public:
 #define RMT_Clock_Divisor   2.0
 #define RMT_TickLengthNS    float ( (1/ (RMT_ClockRate/RMT_Clock_Divisor)) * float(NanoSecondsInASecond))
 
-    void SetIntensity2Rmt (rmt_item32_t NewValue, RmtDataBitIdType_t ID) { Intensity2Rmt[ID] = NewValue; }
+    void SetIntensity2Rmt (rmt_item32_t NewValue, RmtDataBitIdType_t ID);
 
     bool NoFrameInProgress () { return (0 == (RMT.int_ena.val & (RMT_INT_TX_END_BIT | RMT_INT_THR_EVNT_BIT))); }
 
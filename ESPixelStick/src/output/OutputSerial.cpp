@@ -45,6 +45,12 @@ c_OutputSerial::~c_OutputSerial ()
 {
     // DEBUG_START;
 
+    if (nullptr != pDmxLastSentSlots)
+    {
+        free (pDmxLastSentSlots);
+        pDmxLastSentSlots = nullptr;
+    }
+
     // DEBUG_END;
 } // ~c_OutputSerial
 
@@ -71,6 +77,15 @@ void c_OutputSerial::GetConfig(ArduinoJson::JsonObject &jsonConfig)
     jsonConfig[CN_num_chan]    = Num_Channels;
     jsonConfig[CN_baudrate]    = CurrentBaudrate;
 
+#if defined(SUPPORT_OutputType_DMX)
+    if (OutputType == c_OutputMgr::e_OutputType::OutputType_DMX)
+    {
+        jsonConfig[CN_dmxvarlen]    = DmxVariableLength;
+        jsonConfig[CN_dmxrate]      = DmxRefreshRateHz;
+        jsonConfig[CN_dmxkeepalive] = DmxKeepAliveMs;
+    }
+#endif // defined(SUPPORT_OutputType_DMX)
+
     c_OutputCommon::GetConfig (jsonConfig);
 
     // DEBUG_END;
@@ -83,6 +98,15 @@ void c_OutputSerial::GetStatus (ArduinoJson::JsonObject& jsonStatus)
 
     c_OutputCommon::GetStatus (jsonStatus);
 
+#if defined(SUPPORT_OutputType_DMX)
+    if ((OutputType == c_OutputMgr::e_OutputType::OutputType_DMX) && DmxVariableLength)
+    {
+        jsonStatus[F("DmxLastFrameSlots")] = DmxLastFrameSlots;
+        jsonStatus[F("DmxShortFrames")]    = DmxShortFrames;
+        jsonStatus[F("DmxFullFrames")]     = DmxFullFrames;
+    }
+#endif // defined(SUPPORT_OutputType_DMX)
+
 #ifdef USE_SERIAL_DEBUG_COUNTERS
     JsonObject debugStatus = jsonStatus.createNestedObject("Serial Debug");
     debugStatus["Num_Channels"]                = Num_Channels;
@@ -179,6 +203,14 @@ bool c_OutputSerial::SetConfig (ArduinoJson::JsonObject& jsonConfig)
     setFromJSON(GenericSerialFooter, jsonConfig, CN_gen_ser_ftr);
     setFromJSON(Num_Channels,        jsonConfig, CN_num_chan);
     setFromJSON(CurrentBaudrate,     jsonConfig, CN_baudrate);
+#if defined(SUPPORT_OutputType_DMX)
+    setFromJSON(DmxVariableLength,   jsonConfig, CN_dmxvarlen);
+    setFromJSON(DmxRefreshRateHz,    jsonConfig, CN_dmxrate);
+    setFromJSON(DmxKeepAliveMs,      jsonConfig, CN_dmxkeepalive);
+
+    // the receivers may have missed anything we sent before the change
+    DmxSendFullFrame = true;
+#endif // defined(SUPPORT_OutputType_DMX)
 
     c_OutputCommon::SetConfig(jsonConfig);
     bool response = validate();
@@ -220,6 +252,29 @@ bool c_OutputSerial::validate ()
     if (OutputType == c_OutputMgr::e_OutputType::OutputType_DMX)
     {
         CurrentBaudrate = uint32_t(BaudRate::BR_DMX);
+
+        if ((DmxRefreshRateHz < 1) || (DmxRefreshRateHz > DMX_MAX_REFRESH_RATE_HZ))
+        {
+            logcon(CN_stars + String(F(" Requested DMX refresh rate is not valid. Setting to Default ")) + CN_stars);
+            DmxRefreshRateHz = DMX_DEFAULT_REFRESH_RATE_HZ;
+            response = false;
+        }
+
+        if (DmxVariableLength && (DmxLastSentSlotsSize != Num_Channels))
+        {
+            uint8_t * pNewSlots = (uint8_t *)realloc(pDmxLastSentSlots, Num_Channels);
+            if (nullptr == pNewSlots)
+            {
+                logcon(CN_stars + String(F(" Not enough memory for variable length DMX. Sending full frames ")) + CN_stars);
+                DmxVariableLength = false;
+                response = false;
+            }
+            else
+            {
+                pDmxLastSentSlots    = pNewSlots;
+                DmxLastSentSlotsSize = Num_Channels;
+            }
+        }
     }
 #endif // defined(SUPPORT_OutputType_DMX)
 
@@ -242,13 +297,31 @@ bool c_OutputSerial::validate ()
 
 //----------------------------------------------------------------------------
 void c_OutputSerial::SetFrameDurration ()
+{
+    // DEBUG_START;
+
+    FrameMinDurationInMicroSec = CalculateFrameDurration(Num_Channels);
+
+    // DEBUG_END;
+
+} // SetFrameDurration
+
+//----------------------------------------------------------------------------
+uint32_t c_OutputSerial::CalculateFrameDurration (size_t NumSlots)
 {
     // DEBUG_START;
     float IntensityBitTimeInUs     = (1.0 / float(CurrentBaudrate)) * float(MicroSecondsInASecond);
-    float TotalIntensitiesPerFrame = float(Num_Channels + 1) + SerialHeaderSize + SerialFooterSize;
+    float TotalIntensitiesPerFrame = float(NumSlots + 1) + SerialHeaderSize + SerialFooterSize;
     float TotalBitsPerFrame        = float(NumBitsPerIntensity) * TotalIntensitiesPerFrame;
     uint32_t TotalFrameTimeInUs    = uint32_t(IntensityBitTimeInUs * TotalBitsPerFrame) + InterFrameGapInMicroSec;
-    FrameMinDurationInMicroSec     = max(uint32_t(25000), TotalFrameTimeInUs);
+    uint32_t FrameRateLimitInUs    = uint32_t(25000);
+
+#if defined(SUPPORT_OutputType_DMX)
+    if (OutputType == c_OutputMgr::e_OutputType::OutputType_DMX)
+    {
+        FrameRateLimitInUs = max(uint32_t(DMX_MIN_BREAK_TO_BREAK_US), uint32_t(MicroSecondsInASecond / DmxRefreshRateHz));
+    }
+#endif // defined(SUPPORT_OutputType_DMX)
 
     // DEBUG_V (String ("           CurrentBaudrate: ") + String (CurrentBaudrate));
     // DEBUG_V (String ("      IntensityBitTimeInUs: ") + String (IntensityBitTimeInUs));
@@ -259,27 +332,114 @@ void c_OutputSerial::SetFrameDurration ()
     // DEBUG_V (String ("   InterFrameGapInMicroSec: ") + String (InterFrameGapInMicroSec));
     // DEBUG_V (String ("        TotalFrameTimeInUs: ") + String (TotalFrameTimeInUs));
     // DEBUG_V (String ("   InterFrameGapInMicroSec: ") + String (InterFrameGapInMicroSec));
-    // DEBUG_V (String ("FrameMinDurationInMicroSec: ") + String (FrameMinDurationInMicroSec));
+    // DEBUG_V (String ("        FrameRateLimitInUs: ") + String (FrameRateLimitInUs));
 
     // DEBUG_END;
 
-} // SetFrameDurration
+    return max(FrameRateLimitInUs, TotalFrameTimeInUs);
+
+} // CalculateFrameDurration
+
+//----------------------------------------------------------------------------
+/*
+    Variable length DMX can stop a frame after DMX_MIN_SLOTS so the render
+    task has to be ready for the shortest frame, not the full universe.
+*/
+uint32_t c_OutputSerial::GetShortestFrameDurationInMicroSec ()
+{
+    // DEBUG_START;
+
+    uint32_t Response = FrameMinDurationInMicroSec;
+
+#if defined(SUPPORT_OutputType_DMX)
+    if ((OutputType == c_OutputMgr::e_OutputType::OutputType_DMX) && DmxVariableLength)
+    {
+        Response = CalculateFrameDurration(min(Num_Channels, size_t(DMX_MIN_SLOTS)));
+    }
+#endif // defined(SUPPORT_OutputType_DMX)
+
+    // DEBUG_END;
+
+    return Response;
+
+} // GetShortestFrameDurationInMicroSec
+
+//----------------------------------------------------------------------------
+/*
+    Find how many slots the next DMX frame needs. The receivers hold the last
+    value they got so a frame can stop after the highest slot that is either
+    non zero now or was non zero in the last frame that reached it. Every
+    DmxKeepAliveMs a full frame is sent for receivers that missed something.
+*/
+size_t c_OutputSerial::GetDmxFrameSlotCount (size_t NumSlotsAvailable)
+{
+    // DEBUG_START;
+
+    size_t Response = NumSlotsAvailable;
+
+    do // once
+    {
+        if (!DmxVariableLength || (nullptr == pDmxLastSentSlots) || (DmxLastSentSlotsSize < NumSlotsAvailable))
+        {
+            break;
+        }
+
+        uint32_t Now = millis();
+        if (DmxSendFullFrame || (DmxKeepAliveMs && ((Now - DmxLastFullFrameMs) >= DmxKeepAliveMs)))
+        {
+            DmxSendFullFrame   = false;
+            DmxLastFullFrameMs = Now;
+            break;
+        }
+
+        while ((Response > DMX_MIN_SLOTS) &&
+               (0 == (NextIntensityToSend[Response - 1] | pDmxLastSentSlots[Response - 1])))
+        {
+            --Response;
+        }
+
+    } while (false);
+
+    if (DmxVariableLength && (nullptr != pDmxLastSentSlots) && (DmxLastSentSlotsSize >= Response))
+    {
+        memcpy(pDmxLastSentSlots, NextIntensityToSend, Response);
+        if (Response < NumSlotsAvailable)
+        {
+            ++DmxShortFrames;
+        }
+        else
+        {
+            ++DmxFullFrames;
+        }
+    }
+    DmxLastFrameSlots = Response;
+
+    // DEBUG_END;
+
+    return Response;
+
+} // GetDmxFrameSlotCount
 
 //----------------------------------------------------------------------------
 void c_OutputSerial::StartNewFrame ()
 {
     // DEBUG_START;
 
-#ifdef USE_SERIAL_DEBUG_COUNTERS
     if (ISR_MoreDataToSend ())
     {
+        ++Telemetry.AbortedFrames;
+#ifdef USE_SERIAL_DEBUG_COUNTERS
         AbortFrameCounter++;
+#endif // def USE_SERIAL_DEBUG_COUNTERS
     }
+#ifdef USE_SERIAL_DEBUG_COUNTERS
     FrameStartCounter++;
 #endif // def USE_SERIAL_DEBUG_COUNTERS
 
-    NextIntensityToSend = GetBufferAddress();
-    intensity_count     = Num_Channels;
+    LatchFrameBuffer();
+    NextIntensityToSend = GetFrameBufferAddress();
+    // never send more than we have a buffer for
+    intensity_count     = min(Num_Channels, OutputBufferSize);
     SentIntensityCount  = 0;
     SerialHeaderIndex   = 0;
     SerialFooterIndex   = 0;
@@ -297,6 +457,12 @@ void c_OutputSerial::StartNewFrame ()
         case c_OutputMgr::e_OutputType::OutputType_DMX:
         {
             SerialFrameState = SerialFrameState_t::DMXSendFrameStart;
+            if (DmxVariableLength && (nullptr != NextIntensityToSend))
+            {
+                // the next refresh waits for this frame, not a full one
+                intensity_count            = GetDmxFrameSlotCount(intensity_count);
+                FrameMinDurationInMicroSec = CalculateFrameDurration(intensity_count);
+            }
             break;
         }  // DMX512
 #endif // def SUPPORT_OutputType_DMX
@@ -323,6 +489,12 @@ void c_OutputSerial::StartNewFrame ()
 
     } // end switch (OutputType)
 
+    if ((nullptr == NextIntensityToSend) || (0 == intensity_count))
+    {
+        // no buffer has been allocated for this output
+        SerialFrameState = SerialFrameState_t::SerialIdle;
+    }
+
     ReportNewFrame();
 
     // DEBUG_END;
@@ -478,4 +650,40 @@ uint32_t IRAM_ATTR c_OutputSerial::ISR_GetNextIntensityToSend ()
     return data;
 } // NextIntensityToSend
 
+//----------------------------------------------------------------------------
+size_t IRAM_ATTR c_OutputSerial::ISR_EncodeBlock (uint32_t * pTarget, size_t MaxIntensities)
+{
+    size_t NumIntensitiesWritten = 0;
+
+    while ((NumIntensitiesWritten < MaxIntensities) && (SerialFrameState_t::SerialIdle != SerialFrameState))
+    {
+        // DMX and Generic Serial send the channel data as is. Copy a run of it.
+        if (((SerialFrameState_t::DMXSendData == SerialFrameState) ||
+             (SerialFrameState_t::GenSerSendData == SerialFrameState)) &&
+            (1 < intensity_count))
+        {
+            // leave the last channel to the state machine so it can end the data phase
+            size_t NumToCopy = min((MaxIntensities - NumIntensitiesWritten), (intensity_count - 1));
+            intensity_count -= NumToCopy;
+#ifdef USE_SERIAL_DEBUG_COUNTERS
+            IntensityBytesSent += NumToCopy;
+#endif // def USE_SERIAL_DEBUG_COUNTERS
+            while (NumToCopy--)
+            {
+                pTarget[NumIntensitiesWritten++] = *NextIntensityToSend++;
+            }
+
+            if (NumIntensitiesWritten >= MaxIntensities)
+            {
+                break;
+            }
+        }
+
+        pTarget[NumIntensitiesWritten++] = ISR_GetNextIntensityToSend ();
+    }
+
+    return NumIntensitiesWritten;
+
+} // ISR_EncodeBlock
+
 #endif // defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
@@ -41,12 +41,14 @@ public:
     virtual void   GetConfig (ArduinoJson::JsonObject & jsonConfig); ///< Get the current config used by the driver
             void   GetDriverName (String& sDriverName);
     virtual void   GetStatus (ArduinoJson::JsonObject & jsonStatus);
+    virtual uint32_t GetShortestFrameDurationInMicroSec ();
             size_t GetNumChannelsNeeded () { return Num_Channels; };
             void   SetOutputBufferSize (size_t NumChannelsAvailable);
             void   Render() = 0;
             void   StartNewFrame();
             
     uint32_t IRAM_ATTR   ISR_GetNextIntensityToSend();
+    size_t   IRAM_ATTR   ISR_EncodeBlock(uint32_t * pTarget, size_t MaxIntensities); ///< Fill up to MaxIntensities values. Returns the number written
     bool     IRAM_ATTR   ISR_MoreDataToSend() { return (SerialFrameState_t::SerialIdle != SerialFrameState); }
 
 protected:
@@ -69,6 +71,12 @@ protected:
     const uint32_t  DMX_MAB_US       = uint32_t(((1.0 / float(BaudRate::BR_DMX)) *  3.0) * float(MicroSecondsInASecond));  //  3 bits = 12us
     uint32_t InterFrameGapInMicroSec = DMX_BREAK_US + DMX_MAB_US;
 
+#define DMX_MIN_SLOTS                   24      // some receivers drop shorter packets
+#define DMX_MIN_BREAK_TO_BREAK_US       1204    // E1.11 minimum packet period
+#define DMX_DEFAULT_REFRESH_RATE_HZ     40
+#define DMX_MAX_REFRESH_RATE_HZ         (MicroSecondsInASecond / DMX_MIN_BREAK_TO_BREAK_US)
+#define DMX_DEFAULT_KEEP_ALIVE_MS       1000
+
 private:
 
     const size_t    MAX_HDR_SIZE         = 10;      // Max generic serial header size
@@ -106,7 +114,22 @@ private:
     uint32_t   AbortFrameCounter = 0;
 #endif // def USE_SERIAL_DEBUG_COUNTERS
 
+    // Variable length DMX. Frames end at the highest channel that is non zero
+    // now or was non zero in the last frame the receivers saw.
+    bool        DmxVariableLength      = false;
+    uint32_t    DmxRefreshRateHz       = DMX_DEFAULT_REFRESH_RATE_HZ;   ///< Target frame rate
+    uint32_t    DmxKeepAliveMs         = DMX_DEFAULT_KEEP_ALIVE_MS;     ///< Time between full frames. 0 = only send full frames on a config change
+    uint8_t   * pDmxLastSentSlots      = nullptr;                       ///< What the receivers were last sent
+    size_t      DmxLastSentSlotsSize   = 0;
+    bool        DmxSendFullFrame       = true;
+    uint32_t    DmxLastFullFrameMs     = 0;
+    size_t      DmxLastFrameSlots      = 0;
+    uint32_t    DmxShortFrames         = 0;
+    uint32_t    DmxFullFrames          = 0;
+
     bool validate ();        ///< confirm that the current configuration is valid
+    uint32_t CalculateFrameDurration (size_t NumSlots);
+    size_t   GetDmxFrameSlotCount    (size_t NumSlotsAvailable);
 
     enum RenardFrameDefinitions_t
     {
@@ -199,11 +199,12 @@ void c_OutputSerialRmt::Render ()
 {
     // DEBUG_START;
 
-    if (Rmt.Render ())
-    {
-        // DEBUG_V("Report New Frame");
-        ReportNewFrame();
-    }
+    // the serial data source reports the new frame
+    Rmt.Render ();
+
+    // a DMX frame that was cut short at the last changed slot sets a shorter
+    // duration when it starts. The RMT paces the next frame start with its own copy
+    Rmt.SetMinFrameDurationInUs (FrameMinDurationInMicroSec);
 
     // DEBUG_END;
 
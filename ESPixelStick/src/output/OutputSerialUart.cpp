@@ -114,7 +114,6 @@ void c_OutputSerialUart::Render ()
     if (canRefresh())
     {
         Uart.StartNewFrame();
-        ReportNewFrame();
     }
 
     // DEBUG_END;
@@ -21,6 +21,24 @@ GNU General Public License for more details.
 #include <math.h>
 
 #include "OutputServoPCA9685.hpp"
+#include <Wire.h>
+
+#ifdef ARDUINO_ARCH_ESP32
+//----------------------------------------------------------------------------
+static void SendPCA9685DataTask (void * pvParameters)
+{
+    // DEBUG_START; Needs extra stack space to run this
+    do
+    {
+        // wait for Render to hand over a new frame
+        ulTaskNotifyTake (pdTRUE, portMAX_DELAY);
+        reinterpret_cast <c_OutputServoPCA9685*> (pvParameters)->SendChangedChannels ();
+
+    } while (true);
+    // DEBUG_END;
+
+} // SendPCA9685DataTask
+#endif // def ARDUINO_ARCH_ESP32
 
 //----------------------------------------------------------------------------
 c_OutputServoPCA9685::c_OutputServoPCA9685 (c_OutputMgr::e_OutputChannelIds OutputChannelId,
@@ -34,17 +52,23 @@ c_OutputServoPCA9685::c_OutputServoPCA9685 (c_OutputMgr::e_OutputChannelIds Outp
     uint32_t id = 0;
     for (ServoPCA9685Channel_t &currentServoPCA9685Channel : OutputList)
     {
-        currentServoPCA9685Channel.Id               - id++;
+        currentServoPCA9685Channel.Id               = id++;
         currentServoPCA9685Channel.Enabled          = false;
         currentServoPCA9685Channel.MinLevel         = SERVO_PCA9685_OUTPUT_MIN_PULSE_WIDTH;
         currentServoPCA9685Channel.MaxLevel         = SERVO_PCA9685_OUTPUT_MAX_PULSE_WIDTH;
-        currentServoPCA9685Channel.PreviousValue    = 0;
         currentServoPCA9685Channel.IsReversed       = false;
         currentServoPCA9685Channel.Is16Bit          = false;
         currentServoPCA9685Channel.IsScaled         = true;
         currentServoPCA9685Channel.HomeValue        = 0;
     }
 
+    for (Adafruit_PWMServoDriver * & Board : Boards)
+    {
+        Board = nullptr;
+    }
+
+    InvalidateSentValues ();
+
     // DEBUG_END;
 } // c_OutputServoPCA9685
 
@@ -53,11 +77,24 @@ c_OutputServoPCA9685::~c_OutputServoPCA9685 ()
 {
     // DEBUG_START;
 
-    if(nullptr != pwm)
+#ifdef ARDUINO_ARCH_ESP32
+    if (NULL != SendTaskHandle)
+    {
+        // do not pull the task out from under an I2C transaction
+        xSemaphoreTake (I2cMutex, portMAX_DELAY);
+        vTaskDelete (SendTaskHandle);
+        SendTaskHandle = NULL;
+        xSemaphoreGive (I2cMutex);
+    }
+
+    if (NULL != I2cMutex)
     {
-        // DEBUG_V();
-        delete pwm;
+        vSemaphoreDelete (I2cMutex);
+        I2cMutex = NULL;
     }
+#endif // def ARDUINO_ARCH_ESP32
+
+    StopBoards ();
 
     // DEBUG_END;
 } // ~c_OutputServoPCA9685
@@ -69,15 +106,19 @@ void c_OutputServoPCA9685::Begin ()
 
     if(!HasBeenInitialized)
     {
-        // DEBUG_V("Allocate PWM");
-        pwm = new Adafruit_PWMServoDriver();
-
-        SetOutputBufferSize(Num_Channels);
-
-        pwm->begin();
-        pwm->setPWMFreq(UpdateFrequency);
-
         validate();
+        UpdateBoards();
+
+#ifdef ARDUINO_ARCH_ESP32
+        I2cMutex = xSemaphoreCreateMutex ();
+        if ((NULL == I2cMutex) ||
+            (pdPASS != xTaskCreate (SendPCA9685DataTask, "PCA9685Task", 3000, this, ESP_TASK_PRIO_MIN + 4, &SendTaskHandle)))
+        {
+            // Render will do the I2C writes itself
+            logcon (CN_stars + String (F (" Could not start the PCA9685 task ")) + CN_stars);
+            SendTaskHandle = NULL;
+        }
+#endif // def ARDUINO_ARCH_ESP32
 
         HasBeenInitialized = true;
     }
@@ -91,10 +132,10 @@ void c_OutputServoPCA9685::ClearBuffer ()
     // DEBUG_START;
 
     // memset(GetBufferAddress(), 0x00, GetBufferUsedSize());
-    for (ServoPCA9685Channel_t & currentServoPCA9685Channel : OutputList)
+    for (uint16_t ChannelIndex = 0; ChannelIndex < Num_Channels; ++ChannelIndex)
     {
-        GetBufferAddress()[currentServoPCA9685Channel.Id] = 
-            currentServoPCA9685Channel.HomeValue;
+        GetBufferAddress()[OutputList[ChannelIndex].Id] =
+            OutputList[ChannelIndex].HomeValue;
     }
 
     // DEBUG_END;
@@ -106,28 +147,59 @@ bool c_OutputServoPCA9685::validate ()
     // DEBUG_START;
     bool response = true;
 
-    if ((Num_Channels > OM_SERVO_PCA9685_CHANNEL_LIMIT) || (Num_Channels < 1))
+    // drop addresses the PCA9685 cannot have and any duplicates
+    uint8_t NumValidBoards = 0;
+    for (uint8_t BoardIndex = 0; BoardIndex < NumBoards; ++BoardIndex)
     {
-        logcon (CN_stars + String (F (" Requested channel count was not valid. Setting to ")) + OM_SERVO_PCA9685_CHANNEL_LIMIT + " " + CN_stars);
-        Num_Channels = OM_SERVO_PCA9685_CHANNEL_LIMIT;
-        response = false;
-    }
+        uint8_t Address = BoardAddresses[BoardIndex];
+        bool IsValid = (Address >= SERVO_PCA9685_MIN_I2C_ADDRESS) &&
+                       (Address <= SERVO_PCA9685_MAX_I2C_ADDRESS) &&
+                       (Address != SERVO_PCA9685_ALL_CALL_I2C_ADDRESS);
 
-    if (Num_Channels < OM_SERVO_PCA9685_CHANNEL_LIMIT)
-    {
-        logcon (CN_stars + String (F (" Requested channel count was not valid. Insuficient number of input channels avaialable ")) + CN_stars);
+        for (uint8_t PreviousIndex = 0; IsValid && (PreviousIndex < NumValidBoards); ++PreviousIndex)
+        {
+            IsValid = (Address != BoardAddresses[PreviousIndex]);
+        }
 
-        for (int ChannelIndex = OM_SERVO_PCA9685_CHANNEL_LIMIT - 1; ChannelIndex > Num_Channels; ChannelIndex--)
+        if (!IsValid)
         {
-            logcon (CN_stars + String (F (" Disabling channel '")) + String (ChannelIndex + 1) + "' " + CN_stars);
-            OutputList[ChannelIndex].Enabled = false;
+            logcon (CN_stars + String (F (" Ignoring invalid or duplicate PCA9685 address 0x")) + String (Address, HEX) + " " + CN_stars);
+            response = false;
+            continue;
         }
 
-        response = false;
+        BoardAddresses[NumValidBoards++] = Address;
+    }
+
+    if (0 == NumValidBoards)
+    {
+        BoardAddresses[NumValidBoards++] = PCA9685_I2C_ADDRESS;
+    }
+    NumBoards = NumValidBoards;
+
+    // each board takes 16 consecutive channels from the output buffer
+    Num_Channels = NumBoards * SERVO_PCA9685_CHANNELS_PER_BOARD;
+    for (uint16_t ChannelIndex = Num_Channels; ChannelIndex < OM_SERVO_PCA9685_CHANNEL_LIMIT; ++ChannelIndex)
+    {
+        OutputList[ChannelIndex].Enabled = false;
     }
 
     SetOutputBufferSize (Num_Channels);
 
+    // the PCA9685 supports standard, fast and fast mode plus
+    if (I2cClockKhz <= 100)
+    {
+        I2cClockKhz = 100;
+    }
+    else if (I2cClockKhz <= 400)
+    {
+        I2cClockKhz = 400;
+    }
+    else
+    {
+        I2cClockKhz = 1000;
+    }
+
     /*
     uint8_t CurrentServoPCA9685ChanIndex = 0;
     for (ServoPCA9685Channel_t & currentServoPCA9685 : OutputList)
@@ -159,7 +231,23 @@ bool c_OutputServoPCA9685::SetConfig (ArduinoJson::JsonObject & jsonConfig)
 
         // PrettyPrint (jsonConfig, String("c_OutputServoPCA9685::SetConfig"));
         setFromJSON (UpdateFrequency, jsonConfig, OM_SERVO_PCA9685_UPDATE_INTERVAL_NAME);
-        pwm->setPWMFreq (UpdateFrequency);
+        setFromJSON (I2cClockKhz,     jsonConfig, OM_SERVO_PCA9685_I2C_CLOCK_NAME);
+
+        if (jsonConfig.containsKey (OM_SERVO_PCA9685_I2C_ADDRESSES_NAME))
+        {
+            JsonArray JsonAddressList = jsonConfig[OM_SERVO_PCA9685_I2C_ADDRESSES_NAME];
+
+            NumBoards = 0;
+            for (JsonVariant JsonAddress : JsonAddressList)
+            {
+                if (NumBoards >= SERVO_PCA9685_MAX_BOARDS)
+                {
+                    logcon (CN_stars + String (F (" Too many PCA9685 boards. Using the first ")) + String (SERVO_PCA9685_MAX_BOARDS) + " " + CN_stars);
+                    break;
+                }
+                BoardAddresses[NumBoards++] = JsonAddress.as<uint8_t> ();
+            }
+        }
 
         // do we have a channel configuration array?
         if (false == jsonConfig.containsKey (OM_SERVO_PCA9685_CHANNELS_NAME))
@@ -203,6 +291,22 @@ bool c_OutputServoPCA9685::SetConfig (ArduinoJson::JsonObject & jsonConfig)
 
     bool response = validate ();
 
+#ifdef ARDUINO_ARCH_ESP32
+    if (NULL != I2cMutex)
+    {
+        xSemaphoreTake (I2cMutex, portMAX_DELAY);
+    }
+#endif // def ARDUINO_ARCH_ESP32
+
+    UpdateBoards ();
+
+#ifdef ARDUINO_ARCH_ESP32
+    if (NULL != I2cMutex)
+    {
+        xSemaphoreGive (I2cMutex);
+    }
+#endif // def ARDUINO_ARCH_ESP32
+
     // Update the config fields in case the validator changed them
     GetConfig (jsonConfig);
 
@@ -217,12 +321,19 @@ void c_OutputServoPCA9685::GetConfig (ArduinoJson::JsonObject & jsonConfig)
     // DEBUG_START;
 
     jsonConfig[OM_SERVO_PCA9685_UPDATE_INTERVAL_NAME] = UpdateFrequency;
+    jsonConfig[OM_SERVO_PCA9685_I2C_CLOCK_NAME]       = I2cClockKhz;
+
+    JsonArray JsonAddressList = jsonConfig.createNestedArray (OM_SERVO_PCA9685_I2C_ADDRESSES_NAME);
+    for (uint8_t BoardIndex = 0; BoardIndex < NumBoards; ++BoardIndex)
+    {
+        JsonAddressList.add (BoardAddresses[BoardIndex]);
+    }
 
     JsonArray JsonChannelList = jsonConfig.createNestedArray (OM_SERVO_PCA9685_CHANNELS_NAME);
 
-    uint8_t ChannelId = 0;
-    for (ServoPCA9685Channel_t & currentServoPCA9685 : OutputList)
+    for (uint16_t ChannelId = 0; ChannelId < Num_Channels; ++ChannelId)
     {
+        ServoPCA9685Channel_t & currentServoPCA9685 = OutputList[ChannelId];
         JsonObject JsonChannelData = JsonChannelList.createNestedObject ();
 
         JsonChannelData[OM_SERVO_PCA9685_CHANNEL_ID_NAME]       = ChannelId;
@@ -238,8 +349,6 @@ void c_OutputServoPCA9685::GetConfig (ArduinoJson::JsonObject & jsonConfig)
         // DEBUG_V (String ("  Enabled: ") + String (currentServoPCA9685.Enabled));
         // DEBUG_V (String (" MinLevel: ") + String (currentServoPCA9685.MinLevel));
         // DEBUG_V (String (" MaxLevel: ") + String (currentServoPCA9685.MaxLevel));
-
-        ++ChannelId;
     }
 
     // extern void PrettyPrint(JsonObject & jsonStuff, String Name);
@@ -256,73 +365,317 @@ void  c_OutputServoPCA9685::GetDriverName (String & sDriverName)
 } // GetDriverName
 
 //----------------------------------------------------------------------------
-void c_OutputServoPCA9685::Render ()
+void c_OutputServoPCA9685::GetStatus (ArduinoJson::JsonObject & jsonStatus)
 {
     // DEBUG_START;
 
-    uint8_t OutputDataIndex = 0;
-    ReportNewFrame ();
+    c_OutputCommon::GetStatus (jsonStatus);
 
-    for (ServoPCA9685Channel_t & currentServoPCA9685 : OutputList)
+    jsonStatus[F ("Boards")]          = NumBoards;
+    jsonStatus[F ("I2cWrites")]       = I2cWrites;
+    jsonStatus[F ("ChannelsWritten")] = ChannelsWritten;
+    jsonStatus[F ("I2cErrors")]       = I2cErrors;
+
+    // DEBUG_END;
+} // GetStatus
+
+//----------------------------------------------------------------------------
+void c_OutputServoPCA9685::InvalidateSentValues ()
+{
+    // DEBUG_START;
+
+    for (uint16_t & SentValue : SentValues)
     {
-        // DEBUG_V (String("OutputDataIndex: ") + String(OutputDataIndex));
-        // DEBUG_V (String ("       Enabled: ") + String (currentServoPCA9685.Enabled));
-        if (currentServoPCA9685.Enabled)
+        SentValue = SERVO_PCA9685_VALUE_UNKNOWN;
+    }
+
+    // DEBUG_END;
+} // InvalidateSentValues
+
+//----------------------------------------------------------------------------
+void c_OutputServoPCA9685::StopBoards ()
+{
+    // DEBUG_START;
+
+    for (Adafruit_PWMServoDriver * & Board : Boards)
+    {
+        if (nullptr != Board)
         {
-            uint16_t MaxScaledValue = 255;
-            uint16_t MinScaledValue = 0;
-            uint16_t newOutputValue = pOutputBuffer[OutputDataIndex];
+            // DEBUG_V();
+            delete Board;
+            Board = nullptr;
+        }
+    }
+    NumBoardsStarted = 0;
 
-            if (currentServoPCA9685.Is16Bit)
-            {
-                // DEBUG_V ("16 Bit Mode");
-                newOutputValue  = (pOutputBuffer[(OutputDataIndex * 2) + 0] << 0);
-                newOutputValue += (pOutputBuffer[(OutputDataIndex * 2) + 1] << 8);
-                MaxScaledValue = uint16_t (-1);
-            }
+    // DEBUG_END;
+} // StopBoards
 
-            // DEBUG_V (String ("newOutputValue: ") + String (newOutputValue));
-            // DEBUG_V (String (" PreviousValue: ") + String (currentServoPCA9685.PreviousValue));
+//----------------------------------------------------------------------------
+/*
+    Brings the boards in line with the config. Boards are only reset when the
+    address list changes so a config save does not twitch the servos.
+*/
+void c_OutputServoPCA9685::UpdateBoards ()
+{
+    // DEBUG_START;
 
-            if (newOutputValue != currentServoPCA9685.PreviousValue)
-            {
-                // DEBUG_V (String ("ChannelId: ") + String (OutputDataIndex));
-                // DEBUG_V (String (" MinLevel: ") + String (currentServoPCA9685.MinLevel));
-                // DEBUG_V (String (" MaxLevel: ") + String (currentServoPCA9685.MaxLevel));
-                currentServoPCA9685.PreviousValue = newOutputValue;
+    if ((NumBoards != NumBoardsStarted) ||
+        (0 != memcmp (BoardAddresses, StartedAddresses, NumBoards)))
+    {
+        StopBoards ();
 
-                if (currentServoPCA9685.IsReversed)
-                {
-                    // DEBUG_V (String("Reverse Lookup"));
-                    MinScaledValue = MaxScaledValue;
-                    MaxScaledValue = 0;
-                }
+        for (uint8_t BoardIndex = 0; BoardIndex < NumBoards; ++BoardIndex)
+        {
+            // DEBUG_V("Allocate PWM");
+            Boards[BoardIndex] = new Adafruit_PWMServoDriver (BoardAddresses[BoardIndex]);
+            Boards[BoardIndex]->begin ();
+            StartedAddresses[BoardIndex] = BoardAddresses[BoardIndex];
+        }
+        NumBoardsStarted = NumBoards;
+    }
 
-                uint16_t Final_value = newOutputValue;
-                if (currentServoPCA9685.IsScaled)
-                {
-                    // DEBUG_V (String ("Is Scalled"));
-                    // DEBUG_V (String ("newOutputValue: ") + String (newOutputValue));
-                    // DEBUG_V (String ("      MinLevel: ") + String (currentServoPCA9685.MinLevel));
-                    // DEBUG_V (String ("      MaxLevel: ") + String (currentServoPCA9685.MaxLevel));
-                    // DEBUG_V (String ("MinScaledValue: ") + String (MinScaledValue));
-                    // DEBUG_V (String ("MaxScaledValue: ") + String (MaxScaledValue));
-
-                    uint16_t pulse_width = map (newOutputValue,
-                                                MinScaledValue,
-                                                MaxScaledValue,
-                                                currentServoPCA9685.MinLevel,
-                                                currentServoPCA9685.MaxLevel);
-                    Final_value = int((float(pulse_width) / float(MicroSecondsInASecond)) * float(UpdateFrequency) * 4096.0);
-                    // DEBUG_V (String ("pulse_width: ") + String (pulse_width));
-                    // DEBUG_V (String ("Final_value: ") + String (Final_value));
-                }
-                pwm->setPWM (OutputDataIndex, 0, Final_value);
-            }
+    // begin () restarts Wire so set the clock afterwards
+    Wire.setClock (I2cClockKhz * 1000);
+
+    for (uint8_t BoardIndex = 0; BoardIndex < NumBoardsStarted; ++BoardIndex)
+    {
+        Boards[BoardIndex]->setPWMFreq (UpdateFrequency);
+        EnableAutoIncrement (StartedAddresses[BoardIndex]);
+    }
+
+    // the scaling may have changed. Send everything again.
+    InvalidateSentValues ();
+
+    // DEBUG_END;
+} // UpdateBoards
+
+//----------------------------------------------------------------------------
+/*
+    Block writes need the register auto increment bit. The Adafruit driver
+    sets it in setPWMFreq but older versions did not so set it here too.
+*/
+void c_OutputServoPCA9685::EnableAutoIncrement (uint8_t Address)
+{
+    // DEBUG_START;
+
+    do // once
+    {
+        Wire.beginTransmission (Address);
+        Wire.write (PCA9685_MODE1);
+        if (0 != Wire.endTransmission ())
+        {
+            ++I2cErrors;
+            break;
+        }
+
+        if (1 != Wire.requestFrom (Address, uint8_t (1)))
+        {
+            ++I2cErrors;
+            break;
+        }
+        uint8_t Mode1 = Wire.read ();
+
+        if (Mode1 & MODE1_AI)
+        {
+            break;
+        }
+
+        Wire.beginTransmission (Address);
+        Wire.write (PCA9685_MODE1);
+        Wire.write (Mode1 | MODE1_AI);
+        if (0 != Wire.endTransmission ())
+        {
+            ++I2cErrors;
+        }
+
+    } while (false);
+
+    // DEBUG_END;
+} // EnableAutoIncrement
+
+//----------------------------------------------------------------------------
+/*
+    Writes ON = 0 and OFF = value for a run of channels starting at
+    LED<FirstChannel>_ON_L. Same register contents as setPWM (n, 0, value).
+*/
+bool c_OutputServoPCA9685::WriteChannelBlock (uint8_t Address, uint8_t FirstChannel, uint8_t NumChannels, uint16_t * pValues)
+{
+    // DEBUG_START;
+
+    Wire.beginTransmission (Address);
+    Wire.write (PCA9685_LED0_ON_L + (FirstChannel * SERVO_PCA9685_BYTES_PER_CHANNEL));
+
+    for (uint8_t Index = 0; Index < NumChannels; ++Index)
+    {
+        Wire.write (0);
+        Wire.write (0);
+        Wire.write (lowByte (pValues[Index]));
+        Wire.write (highByte (pValues[Index]));
+    }
+
+    ++I2cWrites;
+    ChannelsWritten += NumChannels;
+
+    // DEBUG_END;
+    return (0 == Wire.endTransmission ());
+
+} // WriteChannelBlock
+
+//----------------------------------------------------------------------------
+void c_OutputServoPCA9685::SendChangedChannels ()
+{
+    // DEBUG_START;
+
+    uint16_t Values[OM_SERVO_PCA9685_CHANNEL_LIMIT];
+
+#ifdef ARDUINO_ARCH_ESP32
+    portENTER_CRITICAL (&PendingLock);
+    memcpy (Values, PendingValues, sizeof (Values));
+    portEXIT_CRITICAL (&PendingLock);
+
+    if (NULL != I2cMutex)
+    {
+        xSemaphoreTake (I2cMutex, portMAX_DELAY);
+    }
+#else
+    memcpy (Values, PendingValues, sizeof (Values));
+#endif // def ARDUINO_ARCH_ESP32
+
+    uint16_t Channel = 0;
+    while (Channel < (NumBoardsStarted * SERVO_PCA9685_CHANNELS_PER_BOARD))
+    {
+        if ((SERVO_PCA9685_VALUE_UNKNOWN == Values[Channel]) || (Values[Channel] == SentValues[Channel]))
+        {
+            ++Channel;
+            continue;
+        }
+
+        // collect the run of changed channels that follows. A run never crosses into the next board.
+        uint16_t FirstChannel = Channel;
+        uint16_t BoardIndex   = FirstChannel / SERVO_PCA9685_CHANNELS_PER_BOARD;
+        uint16_t BoardEnd     = (BoardIndex + 1) * SERVO_PCA9685_CHANNELS_PER_BOARD;
+        while ((Channel < BoardEnd) &&
+               ((Channel - FirstChannel) < SERVO_PCA9685_MAX_CHANNELS_PER_WRITE) &&
+               (SERVO_PCA9685_VALUE_UNKNOWN != Values[Channel]) &&
+               (Values[Channel] != SentValues[Channel]))
+        {
+            ++Channel;
+        }
+
+        uint8_t NumChannels = Channel - FirstChannel;
+        if (WriteChannelBlock (StartedAddresses[BoardIndex],
+                               FirstChannel % SERVO_PCA9685_CHANNELS_PER_BOARD,
+                               NumChannels,
+                               &Values[FirstChannel]))
+        {
+            memcpy (&SentValues[FirstChannel], &Values[FirstChannel], NumChannels * sizeof (Values[0]));
+        }
+        else
+        {
+            // leave SentValues alone so the next frame tries again
+            ++I2cErrors;
         }
-        ++OutputDataIndex;
     }
 
+#ifdef ARDUINO_ARCH_ESP32
+    if (NULL != I2cMutex)
+    {
+        xSemaphoreGive (I2cMutex);
+    }
+#endif // def ARDUINO_ARCH_ESP32
+
+    // DEBUG_END;
+} // SendChangedChannels
+
+//----------------------------------------------------------------------------
+uint16_t c_OutputServoPCA9685::CalculateRegisterValue (ServoPCA9685Channel_t & currentServoPCA9685, uint16_t OutputDataIndex)
+{
+    // DEBUG_START;
+
+    uint16_t MaxScaledValue = 255;
+    uint16_t MinScaledValue = 0;
+    uint16_t newOutputValue = pFrameBuffer[OutputDataIndex];
+
+    if (currentServoPCA9685.Is16Bit)
+    {
+        // DEBUG_V ("16 Bit Mode");
+        newOutputValue  = (pFrameBuffer[(OutputDataIndex * 2) + 0] << 0);
+        newOutputValue += (pFrameBuffer[(OutputDataIndex * 2) + 1] << 8);
+        MaxScaledValue = uint16_t (-1);
+    }
+
+    // DEBUG_V (String ("newOutputValue: ") + String (newOutputValue));
+
+    if (currentServoPCA9685.IsReversed)
+    {
+        // DEBUG_V (String("Reverse Lookup"));
+        MinScaledValue = MaxScaledValue;
+        MaxScaledValue = 0;
+    }
+
+    uint16_t Final_value = newOutputValue;
+    if (currentServoPCA9685.IsScaled)
+    {
+        // DEBUG_V (String ("Is Scalled"));
+        // DEBUG_V (String ("      MinLevel: ") + String (currentServoPCA9685.MinLevel));
+        // DEBUG_V (String ("      MaxLevel: ") + String (currentServoPCA9685.MaxLevel));
+        // DEBUG_V (String ("MinScaledValue: ") + String (MinScaledValue));
+        // DEBUG_V (String ("MaxScaledValue: ") + String (MaxScaledValue));
+
+        uint16_t pulse_width = map (newOutputValue,
+                                    MinScaledValue,
+                                    MaxScaledValue,
+                                    currentServoPCA9685.MinLevel,
+                                    currentServoPCA9685.MaxLevel);
+        Final_value = int((float(pulse_width) / float(MicroSecondsInASecond)) * float(UpdateFrequency) * 4096.0);
+        // DEBUG_V (String ("pulse_width: ") + String (pulse_width));
+        // DEBUG_V (String ("Final_value: ") + String (Final_value));
+    }
+
+    // DEBUG_END;
+    return Final_value;
+
+} // CalculateRegisterValue
+
+//----------------------------------------------------------------------------
+void c_OutputServoPCA9685::Render ()
+{
+    // DEBUG_START;
+
+    uint16_t NewValues[OM_SERVO_PCA9685_CHANNEL_LIMIT];
+    ReportNewFrame ();
+    LatchFrameBuffer ();
+
+    for (uint16_t OutputDataIndex = 0; OutputDataIndex < OM_SERVO_PCA9685_CHANNEL_LIMIT; ++OutputDataIndex)
+    {
+        ServoPCA9685Channel_t & currentServoPCA9685 = OutputList[OutputDataIndex];
+        // DEBUG_V (String("OutputDataIndex: ") + String(OutputDataIndex));
+        // DEBUG_V (String ("       Enabled: ") + String (currentServoPCA9685.Enabled));
+        NewValues[OutputDataIndex] = ((OutputDataIndex < Num_Channels) && currentServoPCA9685.Enabled) ?
+                                     CalculateRegisterValue (currentServoPCA9685, OutputDataIndex) :
+                                     SERVO_PCA9685_VALUE_UNKNOWN;
+    }
+
+    do // once
+    {
+#ifdef ARDUINO_ARCH_ESP32
+        if (NULL != SendTaskHandle)
+        {
+            portENTER_CRITICAL (&PendingLock);
+            memcpy (PendingValues, NewValues, sizeof (PendingValues));
+            portEXIT_CRITICAL (&PendingLock);
+
+            xTaskNotifyGive (SendTaskHandle);
+            break;
+        }
+#endif // def ARDUINO_ARCH_ESP32
+
+        memcpy (PendingValues, NewValues, sizeof (PendingValues));
+        SendChangedChannels ();
+
+    } while (false);
+
     // DEBUG_END;
 } // render
 
@@ -35,7 +35,6 @@ private:
         bool        Enabled         = false;
         uint16_t    MinLevel        = SERVO_PCA9685_OUTPUT_MIN_PULSE_WIDTH;
         uint16_t    MaxLevel        = SERVO_PCA9685_OUTPUT_MAX_PULSE_WIDTH;
-        uint16_t    PreviousValue   = 0;
         bool        IsReversed      = false;
         bool        Is16Bit         = false;
         bool        IsScaled        = true;
@@ -58,12 +57,19 @@ public:
     void   GetConfig (ArduinoJson::JsonObject & jsonConfig); ///< Get the current config used by the driver
     void   Render ();                                        ///< Call from loop(),  renders output data
     void   GetDriverName (String& sDriverName);
-    void   GetStatus (ArduinoJson::JsonObject & jsonStatus) { c_OutputCommon::GetStatus (jsonStatus); }
+    void   GetStatus (ArduinoJson::JsonObject & jsonStatus);
     size_t GetNumChannelsNeeded () { return Num_Channels; }
     void   ClearBuffer();
+    void   SendChangedChannels ();                           ///< Writes the pending register values that differ from what the chip has
 
 private:
-#   define OM_SERVO_PCA9685_CHANNEL_LIMIT           16
+#   define SERVO_PCA9685_CHANNELS_PER_BOARD         16
+#ifdef ARDUINO_ARCH_ESP32
+#   define SERVO_PCA9685_MAX_BOARDS                 8
+#else
+#   define SERVO_PCA9685_MAX_BOARDS                 4
+#endif // def ARDUINO_ARCH_ESP32
+#   define OM_SERVO_PCA9685_CHANNEL_LIMIT           (SERVO_PCA9685_MAX_BOARDS * SERVO_PCA9685_CHANNELS_PER_BOARD)
 #   define OM_SERVO_PCA9685_UPDATE_INTERVAL_NAME    CN_updateinterval
 #   define OM_SERVO_PCA9685_CHANNELS_NAME           CN_channels
 #   define OM_SERVO_PCA9685_CHANNEL_ENABLED_NAME    CN_en
@@ -75,18 +81,64 @@ private:
 #   define OM_SERVO_PCA9685_CHANNEL_16BITS          CN_b16
 #   define OM_SERVO_PCA9685_CHANNEL_SCALED          CN_sca
 #   define OM_SERVO_PCA9685_CHANNEL_HOME            CN_hv
+#   define OM_SERVO_PCA9685_I2C_CLOCK_NAME          CN_i2ckhz
+#   define OM_SERVO_PCA9685_I2C_ADDRESSES_NAME      CN_i2caddrs
+#   define SERVO_PCA9685_MIN_I2C_ADDRESS            0x40
+#   define SERVO_PCA9685_MAX_I2C_ADDRESS            0x7F
+#   define SERVO_PCA9685_ALL_CALL_I2C_ADDRESS       0x70
 #   define SERVO_PCA9685_UPDATE_FREQUENCY           50
+#   define SERVO_PCA9685_DEFAULT_I2C_KHZ            400
+#   define SERVO_PCA9685_VALUE_UNKNOWN              uint16_t(-1)
+
+    // bytes per channel in the LEDn_ON_L..LEDn_OFF_H register block
+#   define SERVO_PCA9685_BYTES_PER_CHANNEL          4
+#if defined(I2C_BUFFER_LENGTH)
+#   define SERVO_PCA9685_I2C_BUFFER_LENGTH          I2C_BUFFER_LENGTH
+#elif defined(BUFFER_LENGTH)
+#   define SERVO_PCA9685_I2C_BUFFER_LENGTH          BUFFER_LENGTH
+#else
+#   define SERVO_PCA9685_I2C_BUFFER_LENGTH          32
+#endif
+    // one register address byte followed by as many whole channels as the Wire buffer holds
+#   define SERVO_PCA9685_MAX_CHANNELS_PER_WRITE     min (SERVO_PCA9685_CHANNELS_PER_BOARD, (SERVO_PCA9685_I2C_BUFFER_LENGTH - 1) / SERVO_PCA9685_BYTES_PER_CHANNEL)
 
     bool    validate ();
+    uint16_t CalculateRegisterValue (ServoPCA9685Channel_t & Channel, uint16_t OutputDataIndex);
+    void    UpdateBoards ();
+    void    StopBoards ();
+    void    EnableAutoIncrement (uint8_t Address);
+    void    InvalidateSentValues ();
+    bool    WriteChannelBlock (uint8_t Address, uint8_t FirstChannel, uint8_t NumChannels, uint16_t * pValues);
 
     // config data
     ServoPCA9685Channel_t     OutputList[OM_SERVO_PCA9685_CHANNEL_LIMIT];
-    Adafruit_PWMServoDriver * pwm = nullptr;
+    // board N drives output channels N*16 .. N*16+15
+    uint8_t                   BoardAddresses[SERVO_PCA9685_MAX_BOARDS] = {PCA9685_I2C_ADDRESS};
+    uint8_t                   NumBoards = 1;
+    Adafruit_PWMServoDriver * Boards[SERVO_PCA9685_MAX_BOARDS];
+    uint8_t                   StartedAddresses[SERVO_PCA9685_MAX_BOARDS];
+    uint8_t                   NumBoardsStarted = 0;
     float                     UpdateFrequency = SERVO_PCA9685_UPDATE_FREQUENCY;
+    uint32_t                  I2cClockKhz     = SERVO_PCA9685_DEFAULT_I2C_KHZ;
+
+    // Render fills PendingValues. SendChangedChannels compares them with what
+    // the chip was last sent and writes runs of changed channels in one go.
+    uint16_t    PendingValues[OM_SERVO_PCA9685_CHANNEL_LIMIT];
+    uint16_t    SentValues[OM_SERVO_PCA9685_CHANNEL_LIMIT];
+    uint32_t    I2cWrites       = 0;
+    uint32_t    ChannelsWritten = 0;
+    uint32_t    I2cErrors       = 0;
+
+#ifdef ARDUINO_ARCH_ESP32
+    // I2C traffic runs in its own task so Render never waits on the bus
+    TaskHandle_t        SendTaskHandle = NULL;
+    SemaphoreHandle_t   I2cMutex       = NULL;
+    portMUX_TYPE        PendingLock    = portMUX_INITIALIZER_UNLOCKED;
+#endif // def ARDUINO_ARCH_ESP32
 
     // non config data
     String      OutputName;
-    uint16_t    Num_Channels = OM_SERVO_PCA9685_CHANNEL_LIMIT;
+    uint16_t    Num_Channels = SERVO_PCA9685_CHANNELS_PER_BOARD;
 
 }; // c_OutputServoPCA9685
 
@@ -21,6 +21,7 @@
 
 #include "OutputSpi.hpp"
 #include "driver/spi_master.h"
+#include <esp_heap_caps.h>
 // #include <esp_heap_alloc_caps.h>
 
 //----------------------------------------------------------------------------
@@ -34,12 +35,7 @@ static void IRAM_ATTR spi_transfer_callback (spi_transaction_t * param)
     {
         if (param->user)
         {
-            reinterpret_cast <c_OutputSpi*> (param->user)->DataCbCounter++;
-            TaskHandle_t Handle = reinterpret_cast <c_OutputSpi*> (param->user)->GetTaskHandle ();
-            if (Handle)
-            {
-                vTaskResume (Handle);
-            }
+            reinterpret_cast <c_OutputSpi*> (param->user)->ISR_TransactionDone (param);
         }
         else
         {
@@ -87,6 +83,8 @@ c_OutputSpi::~c_OutputSpi ()
     if(HasBeenInitialized)
     {
         spi_transfer_callback_enabled = false;
+        // the frame buffer is left alone. The DMA engine may still be reading it
+        // and we are about to reboot anyway.
         if (OutputPixel)
         {
             logcon(CN_stars + String(F(" SPI Interface Shutdown requires a reboot ")) + CN_stars);
@@ -103,6 +101,7 @@ void c_OutputSpi::Begin (c_OutputPixel* _OutputPixel)
     // DEBUG_START;
 
     OutputPixel = _OutputPixel;
+    pTelemetry  = &OutputPixel->GetTelemetry ();
 
     NextTransactionToFill = 0;
     for (auto & TransactionBufferToSet : TransactionBuffers)
@@ -114,6 +113,7 @@ void c_OutputSpi::Begin (c_OutputPixel* _OutputPixel)
 
     NextTransactionToFill = 0;
 
+    DeviceMutex = xSemaphoreCreateMutex ();
     xTaskCreate (SendSpiIntensityDataTask, "SPITask", 2000, this, ESP_TASK_PRIO_MIN + 4, &SendIntensityDataTaskHandle);
 
     spi_bus_config_t SpiBusConfiguration;
@@ -123,7 +123,7 @@ void c_OutputSpi::Begin (c_OutputPixel* _OutputPixel)
     SpiBusConfiguration.sclk_io_num = ClockPin;
     SpiBusConfiguration.quadwp_io_num = -1;
     SpiBusConfiguration.quadhd_io_num = -1;
-    SpiBusConfiguration.max_transfer_sz = OM_MAX_NUM_CHANNELS;
+    SpiBusConfiguration.max_transfer_sz = max (OM_MAX_NUM_CHANNELS, SPI_MAX_BYTES_PER_TRANSACTION + 1);
     SpiBusConfiguration.flags = SPICOMMON_BUSFLAG_MASTER;
 
     spi_device_interface_config_t SpiDeviceConfiguration;
@@ -132,7 +132,8 @@ void c_OutputSpi::Begin (c_OutputPixel* _OutputPixel)
     // SpiDeviceConfiguration.address_bits = 0; // No bus address to send
     // SpiDeviceConfiguration.dummy_bits = 0; // No dummy bits to send
     // SpiDeviceConfiguration.duty_cycle_pos = 0; // 50% Duty cycle
-    SpiDeviceConfiguration.clock_speed_hz = SPI_SPI_MASTER_FREQ_1M;
+    ActiveClockHz = GetClockHz ();
+    SpiDeviceConfiguration.clock_speed_hz = ActiveClockHz;
     SpiDeviceConfiguration.mode = 0;                                // SPI mode 0
     SpiDeviceConfiguration.spics_io_num = -1;                       // we will NOT use CS pin
     SpiDeviceConfiguration.queue_size = 10 * SPI_NUM_TRANSACTIONS;    // We want to be able to queue 2 transactions at a time
@@ -152,12 +153,179 @@ void c_OutputSpi::Begin (c_OutputPixel* _OutputPixel)
 
 } // Begin
 
+//----------------------------------------------------------------------------
+void c_OutputSpi::GetConfig (ArduinoJson::JsonObject& jsonConfig)
+{
+    // DEBUG_START;
+
+    jsonConfig[CN_spiframe] = WholeFrameMode;
+    jsonConfig[CN_spimhz]   = ClockMHz;
+
+    // DEBUG_END;
+} // GetConfig
+
+//----------------------------------------------------------------------------
+void c_OutputSpi::GetStatus (ArduinoJson::JsonObject& jsonStatus)
+{
+    // DEBUG_START;
+
+    jsonStatus[F ("SpiWholeFrame")]  = WholeFrameMode;
+    jsonStatus[F ("SpiClockHz")]     = ActiveClockHz;
+    if (WholeFrameMode)
+    {
+        jsonStatus[F ("SpiFrameBytes")]        = FrameLength;
+        jsonStatus[F ("SpiFrameTransactions")] = NumFrameTransactions;
+        jsonStatus[F ("SpiFramesSkippedBusy")] = FramesSkippedBusy;
+        jsonStatus[F ("SpiAllocFailures")]     = FrameBufferAllocFailures;
+    }
+
+    // DEBUG_END;
+} // GetStatus
+
+//----------------------------------------------------------------------------
+/*
+    The new settings are picked up by Render at the next frame boundary. The
+    bus may still be busy sending the previous frame at this point.
+*/
+bool c_OutputSpi::SetConfig (ArduinoJson::JsonObject& jsonConfig)
+{
+    // DEBUG_START;
+
+    setFromJSON (WholeFrameMode, jsonConfig, CN_spiframe);
+    setFromJSON (ClockMHz,       jsonConfig, CN_spimhz);
+
+    ClockMHz = max (uint32_t (1), min (ClockMHz, uint32_t (SPI_MAX_CLOCK_MHZ)));
+
+    // DEBUG_END;
+    return true;
+
+} // SetConfig
+
+//----------------------------------------------------------------------------
+void IRAM_ATTR c_OutputSpi::ISR_TransactionDone (spi_transaction_t * pTransaction)
+{
+    DataCbCounter++;
+
+    if ((pTransaction >= &FrameTransactions[0]) && (pTransaction < &FrameTransactions[SPI_MAX_FRAME_TRANSACTIONS]))
+    {
+        // whole frame transaction. Nothing to refill.
+        if ((pTransaction == &FrameTransactions[NumFrameTransactions - 1]) && (nullptr != pTelemetry))
+        {
+            pTelemetry->WireDone ();
+        }
+    }
+    else if (SendIntensityDataTaskHandle)
+    {
+        vTaskResume (SendIntensityDataTaskHandle);
+    }
+
+} // ISR_TransactionDone
+
+//----------------------------------------------------------------------------
+bool c_OutputSpi::GrowFrameBuffer (size_t MinSize)
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do // once
+    {
+        // grow by at least half so a frame that keeps getting longer does not realloc every block
+        size_t NewSize = max (MinSize, FrameBufferSize + (FrameBufferSize / 2));
+        NewSize = (NewSize + 3) & ~size_t (3);
+
+        byte * pNewBuffer = (byte *)heap_caps_realloc (FrameBuffer, NewSize, MALLOC_CAP_DMA);
+        if (nullptr == pNewBuffer)
+        {
+            ++FrameBufferAllocFailures;
+            break;
+        }
+
+        FrameBuffer     = pNewBuffer;
+        FrameBufferSize = NewSize;
+        Response        = true;
+
+    } while (false);
+
+    // DEBUG_END;
+
+    return Response;
+
+} // GrowFrameBuffer
+
+//----------------------------------------------------------------------------
+/*
+    The IDF has no call to change the clock of an existing device so the
+    device is removed and added again. That is only allowed while it has no
+    queued transactions. In chunk mode the send task queues the chunks, so it
+    is held off with DeviceMutex and the device is only replaced once the
+    task has queued the last chunk of the frame.
+*/
+bool c_OutputSpi::UpdateDevice ()
+{
+    // DEBUG_START;
+
+    bool Response = true;
+
+    xSemaphoreTake (DeviceMutex, portMAX_DELAY);
+
+    do // once
+    {
+        uint32_t NewClockHz = GetClockHz ();
+        if (NewClockHz == ActiveClockHz)
+        {
+            break;
+        }
+
+        if (OutputPixel->ISR_MoreDataToSend ())
+        {
+            // the send task is still feeding the previous frame. Try again on the next frame
+            Response = false;
+            break;
+        }
+
+        spi_device_release_bus (spi_device_handle);
+        if (ESP_OK != spi_bus_remove_device (spi_device_handle))
+        {
+            // still busy. Try again on the next frame
+            ESP_ERROR_CHECK (spi_device_acquire_bus (spi_device_handle, portMAX_DELAY));
+            Response = false;
+            break;
+        }
+
+        spi_device_interface_config_t SpiDeviceConfiguration;
+        memset ( (void*)&SpiDeviceConfiguration, 0x00, sizeof (SpiDeviceConfiguration));
+        SpiDeviceConfiguration.clock_speed_hz = NewClockHz;
+        SpiDeviceConfiguration.mode = 0;
+        SpiDeviceConfiguration.spics_io_num = -1;
+        SpiDeviceConfiguration.queue_size = 10 * SPI_NUM_TRANSACTIONS;
+        SpiDeviceConfiguration.post_cb = spi_transfer_callback;
+
+        ESP_ERROR_CHECK (spi_bus_add_device (SPI_SPI_HOST, &SpiDeviceConfiguration, &spi_device_handle));
+        ESP_ERROR_CHECK (spi_device_acquire_bus (spi_device_handle, portMAX_DELAY));
+
+        ActiveClockHz = NewClockHz;
+        logcon (String (F ("SPI clock set to ")) + String (ActiveClockHz) + F (" Hz"));
+
+    } while (false);
+
+    xSemaphoreGive (DeviceMutex);
+
+    // DEBUG_END;
+
+    return Response;
+
+} // UpdateDevice
+
 //----------------------------------------------------------------------------
 void c_OutputSpi::SendIntensityData ()
 {
     // DEBUG_START;
     SendIntensityDataCounter++;
 
+    // UpdateDevice must not replace the device while we queue on it
+    xSemaphoreTake (DeviceMutex, portMAX_DELAY);
+
     if (OutputPixel->ISR_MoreDataToSend ())
     {
         spi_transaction_t & TransactionToFill = Transactions[NextTransactionToFill];
@@ -168,11 +336,8 @@ void c_OutputSpi::SendIntensityData ()
         TransactionToFill.tx_buffer = pMem;
         uint32_t NumEmptyIntensitySlots = SPI_NUM_INTENSITY_PER_TRANSACTION;
 
-        while ( (NumEmptyIntensitySlots) && (OutputPixel->ISR_MoreDataToSend ()))
-        {
-            *pMem++ = OutputPixel->ISR_GetNextIntensityToSend ();
-            --NumEmptyIntensitySlots;
-        } // end while there is space in the buffer
+        // fill the whole transaction buffer in one call
+        NumEmptyIntensitySlots -= OutputPixel->ISR_EncodeBlock (pMem, SPI_NUM_INTENSITY_PER_TRANSACTION);
 
         TransactionToFill.length = SPI_BITS_PER_INTENSITY * (SPI_NUM_INTENSITY_PER_TRANSACTION - NumEmptyIntensitySlots);
         if (!OutputPixel->ISR_MoreDataToSend ())
@@ -188,6 +353,8 @@ void c_OutputSpi::SendIntensityData ()
         }
     }
 
+    xSemaphoreGive (DeviceMutex);
+
     // DEBUG_END;
 
 } // SendIntensityData
@@ -199,6 +366,130 @@ bool c_OutputSpi::Render ()
 
     // DEBUG_START;
 
+    do // once
+    {
+        // pick up the results of the previous frame. Any left over chunk
+        // results are thrown away so the result queue cannot fill up.
+        spi_transaction_t * pDoneTransaction = nullptr;
+        while (ESP_OK == spi_device_get_trans_result (spi_device_handle, &pDoneTransaction, 0))
+        {
+            if ((pDoneTransaction >= &FrameTransactions[0]) &&
+                (pDoneTransaction < &FrameTransactions[SPI_MAX_FRAME_TRANSACTIONS]) &&
+                (0 != NumFrameTransactionsInFlight))
+            {
+                --NumFrameTransactionsInFlight;
+            }
+        }
+
+        if (0 != NumFrameTransactionsInFlight)
+        {
+            // previous frame is still on the wire
+            ++FramesSkippedBusy;
+            break;
+        }
+
+        if (!UpdateDevice ())
+        {
+            ++FramesSkippedBusy;
+            break;
+        }
+
+        if (WholeFrameMode)
+        {
+            Response = RenderWholeFrame ();
+            break;
+        }
+
+        Response = RenderChunks ();
+
+    } while (false);
+
+    // DEBUG_END;
+
+    return Response;
+} // render
+
+//----------------------------------------------------------------------------
+bool c_OutputSpi::RenderWholeFrame ()
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do // once
+    {
+        OutputPixel->StartNewFrame ();
+
+        // encode the complete frame. Keep one spare byte for the extra clock bit at the end.
+        FrameLength = 0;
+        while (OutputPixel->ISR_MoreDataToSend ())
+        {
+            if ((FrameBufferSize < (FrameLength + SPI_NUM_INTENSITY_PER_TRANSACTION + 1)) &&
+                !GrowFrameBuffer (FrameLength + SPI_NUM_INTENSITY_PER_TRANSACTION + 1))
+            {
+                break;
+            }
+
+            FrameLength += OutputPixel->ISR_EncodeBlock (&FrameBuffer[FrameLength], FrameBufferSize - FrameLength - 1);
+        }
+
+        if (OutputPixel->ISR_MoreDataToSend () || (0 == FrameLength))
+        {
+            // ran out of memory. Do not send a partial frame
+            ++pTelemetry->IncompleteFrames;
+            break;
+        }
+        FrameBuffer[FrameLength] = 0;
+
+        if (FrameLength > (SPI_MAX_FRAME_TRANSACTIONS * SPI_MAX_BYTES_PER_TRANSACTION))
+        {
+            ++pTelemetry->IncompleteFrames;
+            break;
+        }
+
+        // split the frame into as few transactions as the bus allows
+        NumFrameTransactions = 0;
+        size_t Offset = 0;
+        while (Offset < FrameLength)
+        {
+            size_t NumBytes = min (size_t (SPI_MAX_BYTES_PER_TRANSACTION), FrameLength - Offset);
+
+            spi_transaction_t & Transaction = FrameTransactions[NumFrameTransactions++];
+            memset ( (void*)&Transaction, 0x00, sizeof (spi_transaction_t));
+            Transaction.user      = this;
+            Transaction.tx_buffer = &FrameBuffer[Offset];
+            Transaction.length    = SPI_BITS_PER_INTENSITY * NumBytes;
+
+            Offset += NumBytes;
+        }
+        // same trailing clock edge as the last chunk in chunk mode
+        FrameTransactions[NumFrameTransactions - 1].length++;
+
+        pTelemetry->WireStart ();
+        for (uint32_t TransactionId = 0; TransactionId < NumFrameTransactions; ++TransactionId)
+        {
+            ESP_ERROR_CHECK (spi_device_queue_trans (spi_device_handle, &FrameTransactions[TransactionId], portMAX_DELAY));
+            ++NumFrameTransactionsInFlight;
+        }
+
+        spi_transfer_callback_enabled = true;
+        Response = true;
+
+    } while (false);
+
+    // DEBUG_END;
+
+    return Response;
+
+} // RenderWholeFrame
+
+//----------------------------------------------------------------------------
+bool c_OutputSpi::RenderChunks ()
+{
+    bool Response = false;
+
+    // DEBUG_START;
+
     OutputPixel->StartNewFrame ();
 
     // fill all the available buffers
@@ -216,6 +507,6 @@ bool c_OutputSpi::Render ()
     // DEBUG_END;
 
     return Response;
-} // render
+} // RenderChunks
 
 #endif // def SUPPORT_SPI_OUTPUT
@@ -37,7 +37,14 @@ public:
 
     // functions to be provided by the derived class
     void    Begin (c_OutputPixel* _OutputPixel);
+    bool    SetConfig (ArduinoJson::JsonObject& jsonConfig);  ///< Set a new config in the driver
+    void    GetConfig (ArduinoJson::JsonObject& jsonConfig);  ///< Get the current config used by the driver
+    void    GetStatus (ArduinoJson::JsonObject& jsonStatus);
     bool    Render ();                                        ///< Call from loop (),  renders output data
+    uint32_t GetClockHz () { return WholeFrameMode ? (ClockMHz * SPI_SPI_MASTER_FREQ_1M) : SPI_SPI_MASTER_FREQ_1M; }
+    uint16_t GetBlockSize () { return WholeFrameMode ? SPI_MAX_BYTES_PER_TRANSACTION : SPI_NUM_INTENSITY_PER_TRANSACTION; }
+    bool    IsWholeFrameMode () { return WholeFrameMode; }
+    void    IRAM_ATTR ISR_TransactionDone (spi_transaction_t * pTransaction);
     TaskHandle_t GetTaskHandle () { return SendIntensityDataTaskHandle; }
     void    GetDriverName (String& Name) { Name = "OutputSpi"; }
     void    DataOutputTask (void* pvParameters);
@@ -46,15 +53,23 @@ public:
     uint32_t DataTaskcounter = 0;
     uint32_t DataCbCounter = 0;
 
-private:
-
 #define SPI_SPI_MASTER_FREQ_1M               (APB_CLK_FREQ/80) // 1Mhz
+#define SPI_MAX_CLOCK_MHZ                    20
 #define SPI_NUM_TRANSACTIONS                 2
 #define SPI_NUM_INTENSITY_PER_TRANSACTION    128
+#define SPI_MAX_BYTES_PER_TRANSACTION        (4092 * 8)        // eight full DMA descriptors
+#define SPI_MAX_FRAME_TRANSACTIONS           8
 #define SPI_BITS_PER_INTENSITY               8
 #define SPI_SPI_HOST                         VSPI_HOST
 #define SPI_SPI_DMA_CHANNEL                  2
 
+private:
+
+    bool    RenderWholeFrame ();
+    bool    RenderChunks ();
+    bool    GrowFrameBuffer (size_t MinSize);
+    bool    UpdateDevice ();
+
     uint8_t NumIntensityValuesPerInterrupt = 0;
     uint8_t NumIntensityBitsPerInterrupt = 0;
     spi_device_handle_t spi_device_handle = 0;
@@ -68,6 +83,22 @@ private:
     spi_transaction_t Transactions[SPI_NUM_TRANSACTIONS];
     uint8_t NextTransactionToFill = 0;
     TaskHandle_t SendIntensityDataTaskHandle = NULL;
+    SemaphoreHandle_t DeviceMutex = NULL;                     ///< Held by the send task while it queues a chunk and by UpdateDevice while it replaces the device
+
+    // Whole frame mode. The frame is encoded into one DMA capable buffer and sent
+    // as a few large transactions instead of a stream of 128 byte chunks.
+    bool              WholeFrameMode = false;
+    uint32_t          ClockMHz = 1;                           ///< Configured clock. Only used in whole frame mode
+    uint32_t          ActiveClockHz = SPI_SPI_MASTER_FREQ_1M; ///< Clock the device is currently set up for
+    byte            * FrameBuffer = nullptr;
+    size_t            FrameBufferSize = 0;
+    size_t            FrameLength = 0;
+    spi_transaction_t FrameTransactions[SPI_MAX_FRAME_TRANSACTIONS];
+    uint32_t          NumFrameTransactions = 0;
+    uint32_t          NumFrameTransactionsInFlight = 0;
+    uint32_t          FramesSkippedBusy = 0;
+    uint32_t          FrameBufferAllocFailures = 0;
+    c_OutputTelemetry * pTelemetry = nullptr;
 
     gpio_num_t DataPin = DEFAULT_SPI_DATA_GPIO;
     gpio_num_t ClockPin = DEFAULT_SPI_CLOCK_GPIO;
@@ -136,11 +136,8 @@ void c_OutputTLS3001Rmt::Render ()
     {
         pCurrentFsmState->Poll (this);
 
-        // output the frame
-        if (Rmt.Render ())
-        {
-            ReportNewFrame ();
-        }
+        // output the frame. The pixel data source reports the new frame
+        Rmt.Render ();
     }
 
     // DEBUG_END;
@@ -148,10 +148,8 @@ void c_OutputTM1814Rmt::Render ()
 {
     // DEBUG_START;
 
-    if (Rmt.Render ())
-    {
-        ReportNewFrame ();
-    }
+    // the pixel data source reports the new frame
+    Rmt.Render ();
 
     // DEBUG_END;
 
@@ -0,0 +1,152 @@
+/*
+* OutputTelemetry.cpp - Per output frame timing and ISR load statistics
+*
+* Project: ESPixelStick - An ESP8266 / ESP32 and E1.31 based pixel driver
+* Copyright (c) 2026 ESPixelStick contributors
+*
+*  This program is provided free for you to use in any way that you wish,
+*  subject to the laws and regulations where you are using it.  Due diligence
+*  is strongly suggested before using this code.  Please give credit where due.
+*
+*  The Author makes no warranty of any kind, express or implied, with regard
+*  to this program or the documentation contained in this document.  The
+*  Author shall not be liable in any event for incidental or consequential
+*  damages in connection with, or arising out of, the furnishing, performance
+*  or use of these programs.
+*
+*/
+
+#include "../ESPixelStick.h"
+#include "OutputTelemetry.hpp"
+
+//----------------------------------------------------------------------------
+void c_OutputTelemetry::c_Stat::GetValues (uint32_t & MinValue, uint32_t & AvgValue, uint32_t & MaxValue)
+{
+    if (HaveLast)
+    {
+        MinValue = LastMin;
+        AvgValue = LastAvg;
+        MaxValue = LastMax;
+    }
+    else
+    {
+        // still filling the first window
+        MinValue = Min;
+        AvgValue = (0 == Count) ? 0 : uint32_t (Sum / Count);
+        MaxValue = Max;
+    }
+
+} // GetValues
+
+//----------------------------------------------------------------------------
+void c_OutputTelemetry::c_Stat::GetStatus (JsonObject & jsonStatus, float Scale)
+{
+    uint32_t MinValue;
+    uint32_t AvgValue;
+    uint32_t MaxValue;
+    GetValues (MinValue, AvgValue, MaxValue);
+
+    jsonStatus[F ("min")] = uint32_t (float (MinValue) * Scale);
+    jsonStatus[F ("avg")] = uint32_t (float (AvgValue) * Scale);
+    jsonStatus[F ("max")] = uint32_t (float (MaxValue) * Scale);
+
+} // GetStatus
+
+//----------------------------------------------------------------------------
+void c_OutputTelemetry::c_Stat::Reset ()
+{
+    Count    = 0;
+    Sum      = 0;
+    HaveLast = false;
+
+} // Reset
+
+//----------------------------------------------------------------------------
+void c_OutputTelemetry::Reset ()
+{
+    // DEBUG_START;
+
+    FramePeriodInMicroSec.Reset ();
+    StartOffsetInMicroSec.Reset ();
+    WireTimeInCycles.Reset ();
+    IsrCyclesPerFrame.Reset ();
+    IsrCyclesThisFrame = 0;
+    IncompleteFrames   = 0;
+    AbortedFrames      = 0;
+    Overruns           = 0;
+
+    // DEBUG_END;
+} // Reset
+
+//----------------------------------------------------------------------------
+/*
+    FramePeriodInMicroSec is zero for the first frame after a (re)start.
+    StartOffsetInMicroSec is how late the frame started relative to the
+    frame clock tick it was rendered for.
+*/
+void c_OutputTelemetry::StartFrame (uint32_t FramePeriod, uint32_t StartOffset)
+{
+    // DEBUG_START;
+
+    if (0 != FramePeriod)
+    {
+        FramePeriodInMicroSec.Add (FramePeriod);
+    }
+
+#ifdef USE_OUTPUT_TELEMETRY
+    // outputs that are not ISR driven never report any cycles
+    if (0 != IsrCyclesThisFrame)
+    {
+        IsrCyclesPerFrame.Add (IsrCyclesThisFrame);
+        IsrCyclesThisFrame = 0;
+    }
+#endif // def USE_OUTPUT_TELEMETRY
+
+    StartOffsetInMicroSec.Add (StartOffset);
+
+    // DEBUG_END;
+} // StartFrame
+
+//----------------------------------------------------------------------------
+void c_OutputTelemetry::GetStatus (JsonObject & jsonStatus)
+{
+    // DEBUG_START;
+
+    if (FramePeriodInMicroSec.HasData ())
+    {
+        uint32_t MinPeriod;
+        uint32_t AvgPeriod;
+        uint32_t MaxPeriod;
+        FramePeriodInMicroSec.GetValues (MinPeriod, AvgPeriod, MaxPeriod);
+
+        // the longest period is the lowest frame rate
+        JsonObject FpsStatus = jsonStatus.createNestedObject (F ("fps"));
+        FpsStatus[F ("min")] = (0 == MaxPeriod) ? 0 : (MicroSecondsInASecond / MaxPeriod);
+        FpsStatus[F ("avg")] = (0 == AvgPeriod) ? 0 : (MicroSecondsInASecond / AvgPeriod);
+        FpsStatus[F ("max")] = (0 == MinPeriod) ? 0 : (MicroSecondsInASecond / MinPeriod);
+    }
+
+    JsonObject JitterStatus = jsonStatus.createNestedObject (F ("jitterus"));
+    StartOffsetInMicroSec.GetStatus (JitterStatus);
+
+    float MicroSecPerCycle = 1.0 / float (ESP.getCpuFreqMHz ());
+    if (WireTimeInCycles.HasData ())
+    {
+        JsonObject WireStatus = jsonStatus.createNestedObject (F ("wireus"));
+        WireTimeInCycles.GetStatus (WireStatus, MicroSecPerCycle);
+    }
+
+#ifdef USE_OUTPUT_TELEMETRY
+    if (IsrCyclesPerFrame.HasData ())
+    {
+        JsonObject IsrStatus = jsonStatus.createNestedObject (F ("isrcycles"));
+        IsrCyclesPerFrame.GetStatus (IsrStatus);
+    }
+#endif // def USE_OUTPUT_TELEMETRY
+
+    jsonStatus[F ("incomplete")] = IncompleteFrames;
+    jsonStatus[F ("aborted")]    = AbortedFrames;
+    jsonStatus[F ("overruns")]   = Overruns;
+
+    // DEBUG_END;
+} // GetStatus
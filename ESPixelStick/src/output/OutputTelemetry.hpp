@@ -0,0 +1,103 @@
+#pragma once
+/*
+* OutputTelemetry.hpp - Per output frame timing and ISR load statistics
+*
+* Project: ESPixelStick - An ESP8266 / ESP32 and E1.31 based pixel driver
+* Copyright (c) 2026 ESPixelStick contributors
+*
+*  This program is provided free for you to use in any way that you wish,
+*  subject to the laws and regulations where you are using it.  Due diligence
+*  is strongly suggested before using this code.  Please give credit where due.
+*
+*  The Author makes no warranty of any kind, express or implied, with regard
+*  to this program or the documentation contained in this document.  The
+*  Author shall not be liable in any event for incidental or consequential
+*  damages in connection with, or arising out of, the furnishing, performance
+*  or use of these programs.
+*
+*   Frame rate, start jitter, wire time and the error counters are always
+*   kept. The ISR load samples add two cycle counter reads to every output
+*   interrupt and are only compiled in when USE_OUTPUT_TELEMETRY is defined.
+*
+*/
+
+#include "../ESPixelStick.h"
+
+// #define USE_OUTPUT_TELEMETRY
+
+// Number of samples in one min/avg/max window
+#define OUTPUT_TELEMETRY_WINDOW_SIZE 64
+
+class c_OutputTelemetry
+{
+public:
+    // min/avg/max over a window of samples. Reports the last complete window
+    class c_Stat
+    {
+    public:
+        inline void IRAM_ATTR Add (uint32_t Value)
+        {
+            Min  = (0 == Count) ? Value : min (Min, Value);
+            Max  = (0 == Count) ? Value : max (Max, Value);
+            Sum += Value;
+
+            if (++Count >= OUTPUT_TELEMETRY_WINDOW_SIZE)
+            {
+                LastMin   = Min;
+                LastAvg   = uint32_t (Sum / Count);
+                LastMax   = Max;
+                HaveLast  = true;
+                Sum       = 0;
+                Count     = 0;
+            }
+        }
+
+        bool HasData () { return HaveLast || (0 != Count); }
+        void GetValues (uint32_t & MinValue, uint32_t & AvgValue, uint32_t & MaxValue);
+        void GetStatus (JsonObject & jsonStatus, float Scale = 1.0);
+        void Reset ();
+
+    private:
+        uint32_t Min      = 0;
+        uint32_t Max      = 0;
+        uint64_t Sum      = 0;
+        uint32_t Count    = 0;
+        uint32_t LastMin  = 0;
+        uint32_t LastAvg  = 0;
+        uint32_t LastMax  = 0;
+        bool     HaveLast = false;
+    };
+
+    c_OutputTelemetry  () {}
+    ~c_OutputTelemetry () {}
+
+    void GetStatus (JsonObject & jsonStatus);
+    void Reset     ();
+
+    void StartFrame (uint32_t FramePeriod, uint32_t StartOffset);  ///< Called once per frame when the frame starts. Times in us
+
+    // called by the ISR drivers
+    inline void IRAM_ATTR WireStart () { WireStartCycle = ESP.getCycleCount (); }
+    inline void IRAM_ATTR WireDone  () { WireTimeInCycles.Add (ESP.getCycleCount () - WireStartCycle); }
+#ifdef USE_OUTPUT_TELEMETRY
+    static inline uint32_t IRAM_ATTR GetCycleCount () { return ESP.getCycleCount (); }
+    inline void IRAM_ATTR AddIsrCycles (uint32_t Cycles) { IsrCyclesThisFrame += Cycles; }
+#else
+    static inline uint32_t IRAM_ATTR GetCycleCount () { return 0; }
+    inline void IRAM_ATTR AddIsrCycles (uint32_t) {}
+#endif // def USE_OUTPUT_TELEMETRY
+
+    volatile uint32_t IncompleteFrames = 0;    ///< Output ran out of data before the frame was done
+    volatile uint32_t AbortedFrames    = 0;    ///< New frame started before the previous one was sent
+    volatile uint32_t Overruns         = 0;    ///< Refill came too late to keep the hardware buffer full
+
+private:
+    c_Stat   FramePeriodInMicroSec;
+    c_Stat   StartOffsetInMicroSec;
+    c_Stat   WireTimeInCycles;
+    c_Stat   IsrCyclesPerFrame;
+
+    volatile uint32_t IsrCyclesThisFrame = 0;
+    uint32_t          WireStartCycle     = 0;
+
+}; // c_OutputTelemetry
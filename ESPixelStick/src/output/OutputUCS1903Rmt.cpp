@@ -143,10 +143,8 @@ void c_OutputUCS1903Rmt::Render ()
 {
     // DEBUG_START;
 
-    if (Rmt.Render ())
-    {
-        ReportNewFrame ();
-    }
+    // the pixel data source reports the new frame
+    Rmt.Render ();
 
     // DEBUG_END;
 
@@ -137,7 +137,6 @@ void c_OutputUCS1903Uart::Render ()
 
     // get the next frame started
     Uart.StartNewFrame ();
-    ReportNewFrame ();
 
     // DEBUG_END;
 
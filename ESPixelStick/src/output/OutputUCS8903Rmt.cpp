@@ -147,10 +147,8 @@ void c_OutputUCS8903Rmt::Render ()
 {
     // DEBUG_START;
 
-    if (Rmt.Render ())
-    {
-        ReportNewFrame ();
-    }
+    // the pixel data source reports the new frame
+    Rmt.Render ();
 
     // DEBUG_END;
 
@@ -48,12 +48,20 @@ extern "C"
 #endif
 } // extern C
 
+#ifdef SUPPORT_UART_DMA
+#   include <driver/periph_ctrl.h>
+#   include <esp_heap_caps.h>
+#endif // def SUPPORT_UART_DMA
+
 #ifndef UART_INV_MASK
 #   define UART_INV_MASK (0x3f << 19)
 #endif // ndef UART_INV_MASK
 
 // forward declaration for the isr handler
 static void IRAM_ATTR uart_intr_handler (void* param);
+#ifdef SUPPORT_UART_DMA
+static void IRAM_ATTR uhci_intr_handler (void* param);
+#endif // def SUPPORT_UART_DMA
 #ifdef ARDUINO_ARCH_ESP8266
 static c_OutputUart *OutputTimerArray[c_OutputMgr::e_OutputChannelIds::OutputChannelId_End];
 #endif // def ARDUINO_ARCH_ESP8266
@@ -142,6 +150,10 @@ c_OutputUart::~c_OutputUart ()
     // DEBUG_START;
 
     TerminateUartOperation();
+#ifdef SUPPORT_UART_DMA
+    FreeDmaBuffers();
+#endif // def SUPPORT_UART_DMA
+    FreeIntensity2UartWords();
 
 #ifdef ARDUINO_ARCH_ESP8266
 
@@ -173,6 +185,18 @@ static void IRAM_ATTR uart_intr_handler (void* param)
 
 } // uart_intr_handler
 
+#ifdef SUPPORT_UART_DMA
+//----------------------------------------------------------------------------
+static void IRAM_ATTR uhci_intr_handler (void* param)
+{
+    if (param)
+    {
+        reinterpret_cast<c_OutputUart *>(param)->ISR_DMA_Handler();
+    }
+
+} // uhci_intr_handler
+#endif // def SUPPORT_UART_DMA
+
 //----------------------------------------------------------------------------
 void c_OutputUart::Begin (OutputUartConfig_t & config )
 {
@@ -194,6 +218,17 @@ void c_OutputUart::Begin (OutputUartConfig_t & config )
             break;
         }
 
+        if (nullptr != OutputUartConfig.pPixelDataSource)
+        {
+            pTelemetry = &OutputUartConfig.pPixelDataSource->GetTelemetry ();
+        }
+#if defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
+        else
+        {
+            pTelemetry = &OutputUartConfig.pSerialDataSource->GetTelemetry ();
+        }
+#endif // defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
+
         // initial data width
         SetIntensityDataWidth();
 
@@ -210,6 +245,7 @@ void c_OutputUart::Begin (OutputUartConfig_t & config )
                 CurrentTranslation++;
             }
         }
+        UpdateIntensity2UartWords();
 
         LastFrameStartTime = millis();
 
@@ -282,6 +318,9 @@ void c_OutputUart::GetConfig(JsonObject &jsonConfig)
     // enums need to be converted to uints for json
     // jsonConfig[CN_data_pin] = uint8_t(OutputUartConfig.DataPin);
     jsonConfig[CN_baudrate] = OutputUartConfig.Baudrate;
+#ifdef SUPPORT_UART_DMA
+    jsonConfig[CN_uartdma]  = OutputUartConfig.UseDma;
+#endif // def SUPPORT_UART_DMA
     // DEBUG_V(String(" DataPin: ") + String(OutputUartConfig.DataPin));
     // DEBUG_V(String("Baudrate: ") + String(OutputUartConfig.Baudrate));
 
@@ -293,6 +332,11 @@ void c_OutputUart::GetStatus(ArduinoJson::JsonObject &jsonStatus)
 {
     // DEBUG_START;
 
+#ifdef SUPPORT_UART_DMA
+    jsonStatus[F("UartDma")]        = DmaIsActive;
+    jsonStatus[F("DmaBufferBytes")] = DmaBuffers[0].Size + DmaBuffers[1].Size;
+#endif // def SUPPORT_UART_DMA
+
 #ifdef USE_UART_DEBUG_COUNTERS
     JsonObject debugStatus = jsonStatus.createNestedObject("UART Debug");
     debugStatus["ChannelId"]                     = OutputUartConfig.ChannelId;
@@ -545,21 +589,21 @@ bool IRAM_ATTR c_OutputUart::MoreDataToSend()
 } // MoreDataToSend
 
 //----------------------------------------------------------------------------
-uint32_t IRAM_ATTR c_OutputUart::GetNextIntensityToSend()
+size_t IRAM_ATTR c_OutputUart::GetNextIntensityBlock(uint32_t * pTarget, size_t MaxIntensities)
 {
     if (nullptr != OutputUartConfig.pPixelDataSource)
     {
-        return OutputUartConfig.pPixelDataSource->ISR_GetNextIntensityToSend();
+        return OutputUartConfig.pPixelDataSource->ISR_EncodeBlock(pTarget, MaxIntensities);
     }
     else
     {
 #if defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
-        return OutputUartConfig.pSerialDataSource->ISR_GetNextIntensityToSend();
+        return OutputUartConfig.pSerialDataSource->ISR_EncodeBlock(pTarget, MaxIntensities);
 #else
         return 0;
 #endif // defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
     }
-} // GetNextIntensityToSend
+} // GetNextIntensityBlock
 
 //----------------------------------------------------------------------------
 void IRAM_ATTR c_OutputUart::StartNewDataFrame()
@@ -602,6 +646,8 @@ void IRAM_ATTR c_OutputUart::enqueueUartData(uint8_t value)
 //----------------------------------------------------------------------------
 void IRAM_ATTR c_OutputUart::ISR_UART_Handler()
 {
+    uint32_t IsrStartCycle = c_OutputTelemetry::GetCycleCount ();
+
     do // once
     {
 #ifdef USE_UART_DEBUG_COUNTERS
@@ -643,6 +689,16 @@ void IRAM_ATTR c_OutputUart::ISR_UART_Handler()
 #ifdef USE_UART_DEBUG_COUNTERS
                 FrameEndISRcounter++;
 #endif // def USE_UART_DEBUG_COUNTERS
+                // wire time ends when the last byte goes into the FIFO
+                if (nullptr != pTelemetry)
+                {
+                    pTelemetry->WireDone ();
+                }
+            }
+
+            if (nullptr != pTelemetry)
+            {
+                pTelemetry->AddIsrCycles (c_OutputTelemetry::GetCycleCount () - IsrStartCycle);
             }
 
         } // end Our uart generated an interrupt
@@ -682,6 +738,8 @@ void c_OutputUart::CalculateInterIntensityMabTime()
 //----------------------------------------------------------------------------
 void IRAM_ATTR c_OutputUart::ISR_Timer_Handler()
 {
+    uint32_t IsrStartCycle = c_OutputTelemetry::GetCycleCount ();
+
 #ifdef USE_UART_DEBUG_COUNTERS
     TimerIsrCounter++;
 #endif // def USE_UART_DEBUG_COUNTERS
@@ -710,6 +768,14 @@ void IRAM_ATTR c_OutputUart::ISR_Timer_Handler()
             FrameEndISRcounter++;
         }
 #endif // def USE_UART_DEBUG_COUNTERS
+        if (nullptr != pTelemetry)
+        {
+            if (!MoreDataToSend())
+            {
+                pTelemetry->WireDone ();
+            }
+            pTelemetry->AddIsrCycles (c_OutputTelemetry::GetCycleCount () - IsrStartCycle);
+        }
     }
 #ifdef USE_UART_DEBUG_COUNTERS
     else
@@ -721,6 +787,93 @@ void IRAM_ATTR c_OutputUart::ISR_Timer_Handler()
 } // ISR_Timer_Handler
 #endif // def ARDUINO_ARCH_ESP8266
 
+//----------------------------------------------------------------------------
+// Four UART bytes, low byte first. The FIFO register only takes one byte per write
+inline void IRAM_ATTR c_OutputUart::enqueueUartWord(uint32_t value)
+{
+#ifdef USE_UART_DEBUG_COUNTERS
+    EnqueueCounter += 4;
+#endif // def USE_UART_DEBUG_COUNTERS
+#ifdef ARDUINO_ARCH_ESP8266
+    U1F = (char)(value);
+    U1F = (char)(value >> 8);
+    U1F = (char)(value >> 16);
+    U1F = (char)(value >> 24);
+#elif defined(ARDUINO_ARCH_ESP32)
+    volatile uint32_t * pFifo = (volatile uint32_t *)(UART_FIFO_AHB_REG(OutputUartConfig.UartId));
+    *pFifo = (value)       & 0xFF;
+    *pFifo = (value >> 8)  & 0xFF;
+    *pFifo = (value >> 16) & 0xFF;
+    *pFifo = (value >> 24) & 0xFF;
+#endif // defined(ARDUINO_ARCH_ESP32)
+} // enqueueUartWord
+
+//----------------------------------------------------------------------------
+inline size_t IRAM_ATTR c_OutputUart::TranslateIntensityValue(uint32_t IntensityValue, uint8_t * pTarget)
+{
+    uint8_t * pCurrentTarget = pTarget;
+
+    if (nullptr != pIntensity2UartWords)
+    {
+        size_t NumBytesPerDataByte = NumUartWordsPerDataByte * sizeof(uint32_t);
+        for (int32_t Shift = int32_t(OutputUartConfig.IntensityDataWidth) - 8; 0 <= Shift; Shift -= 8)
+        {
+            memcpy(pCurrentTarget, &pIntensity2UartWords[((IntensityValue >> Shift) & 0xFF) * NumUartWordsPerDataByte], NumBytesPerDataByte);
+            pCurrentTarget += NumBytesPerDataByte;
+        }
+#ifdef USE_UART_DEBUG_COUNTERS
+        IntensityBitsSent += OutputUartConfig.IntensityDataWidth;
+#endif // def USE_UART_DEBUG_COUNTERS
+    } // end table lookup
+
+    else if (OutputUartConfig.TranslateIntensityData == TranslateIntensityData_t::NoTranslation)
+    {
+        for (uint32_t count = 0; count < NumUartSlotsPerIntensityValue; count++)
+        {
+            *pCurrentTarget++ = uint8_t(IntensityValue & 0xFF);
+            IntensityValue >>= 8;
+#ifdef USE_UART_DEBUG_COUNTERS
+            IntensityBitsSent += 8;
+#endif // def USE_UART_DEBUG_COUNTERS
+        }
+    } // end no translation
+
+    else if (OutputUartConfig.TranslateIntensityData == TranslateIntensityData_t::OneToOne)
+    { // 1:1
+        for (uint32_t mask = TxIntensityDataStartingMask; 0 != mask; mask >>= 1)
+        {
+            // convert the intensity data into UART data
+            *pCurrentTarget++ = Intensity2Uart[(IntensityValue & mask) ? UartDataBitTranslationId_t::Uart_DATA_BIT_01_ID : UartDataBitTranslationId_t::Uart_DATA_BIT_00_ID];
+#ifdef USE_UART_DEBUG_COUNTERS
+            IntensityBitsSent += 1;
+#endif // def USE_UART_DEBUG_COUNTERS
+        }
+    } // end 1:1
+
+    else // 2:1
+    {
+        // Mask is used as a shift counter that is decremented by 2.
+        for (uint32_t NumBitsToShift = TxIntensityDataStartingMask - 2;
+             0 < NumBitsToShift;
+             NumBitsToShift -= 2)
+        {
+            // convert the intensity data into UART data
+            *pCurrentTarget++ = Intensity2Uart[(IntensityValue >> NumBitsToShift) & 0x3];
+#ifdef USE_UART_DEBUG_COUNTERS
+            IntensityBitsSent += 2;
+#endif // def USE_UART_DEBUG_COUNTERS
+        }
+        // handle the last two bits
+        *pCurrentTarget++ = Intensity2Uart[IntensityValue & 0x3];
+#ifdef USE_UART_DEBUG_COUNTERS
+        IntensityBitsSent += 2;
+#endif    // def USE_UART_DEBUG_COUNTERS
+    } // end 2:1
+
+    return size_t(pCurrentTarget - pTarget);
+
+} // TranslateIntensityValue
+
 //----------------------------------------------------------------------------
 void IRAM_ATTR c_OutputUart::ISR_Handler_SendIntensityData ()
 {
@@ -736,58 +889,47 @@ void IRAM_ATTR c_OutputUart::ISR_Handler_SendIntensityData ()
     }
 #endif // def USE_UART_DEBUG_COUNTERS
 
+    // only one intensity value can be sent between inter intensity breaks
+    size_t MaxIntensitiesPerBlock = (OutputUartConfig.NumInterIntensityBreakBits) ? 1 : UART_INTENSITY_BLOCK_SIZE;
+    uint32_t IntensityBlock[UART_INTENSITY_BLOCK_SIZE];
+
     while (MoreDataToSend() && NumAvailableIntensitySlotsToFill)
     {
-#ifdef USE_UART_DEBUG_COUNTERS
-        IntensityValuesSent++;
-#endif // def USE_UART_DEBUG_COUNTERS
+        size_t NumIntensities = GetNextIntensityBlock(IntensityBlock, min(NumAvailableIntensitySlotsToFill, MaxIntensitiesPerBlock));
+        NumAvailableIntensitySlotsToFill -= NumIntensities;
 
-        NumAvailableIntensitySlotsToFill--;
-
-        uint32_t IntensityValue = GetNextIntensityToSend();
-        if (OutputUartConfig.TranslateIntensityData == TranslateIntensityData_t::NoTranslation)
+        for (size_t IntensityIndex = 0; IntensityIndex < NumIntensities; ++IntensityIndex)
         {
-            for (uint32_t count = 0; count < NumUartSlotsPerIntensityValue; count++)
-            {
-                enqueueUartData(IntensityValue & 0xFF);
-                IntensityValue >>= 8;
 #ifdef USE_UART_DEBUG_COUNTERS
-                IntensityBitsSent += 8;
+            IntensityValuesSent++;
 #endif // def USE_UART_DEBUG_COUNTERS
-            }
-        } // end no translation
 
-        else if (OutputUartConfig.TranslateIntensityData == TranslateIntensityData_t::OneToOne)
-        { // 1:1
-            for (uint32_t mask = TxIntensityDataStartingMask; 0 != mask; mask >>= 1)
+            if (nullptr != pIntensity2UartWords)
             {
-                // convert the intensity data into UART data
-                enqueueUartData(Intensity2Uart[(IntensityValue & mask) ? UartDataBitTranslationId_t::Uart_DATA_BIT_01_ID : UartDataBitTranslationId_t::Uart_DATA_BIT_00_ID]);
+                uint32_t IntensityValue = IntensityBlock[IntensityIndex];
+                for (int32_t Shift = int32_t(OutputUartConfig.IntensityDataWidth) - 8; 0 <= Shift; Shift -= 8)
+                {
+                    const uint32_t * pWords = &pIntensity2UartWords[((IntensityValue >> Shift) & 0xFF) * NumUartWordsPerDataByte];
+                    enqueueUartWord(pWords[0]);
+                    if (2 == NumUartWordsPerDataByte)
+                    {
+                        enqueueUartWord(pWords[1]);
+                    }
+                }
 #ifdef USE_UART_DEBUG_COUNTERS
-                IntensityBitsSent += 1;
+                IntensityBitsSent += OutputUartConfig.IntensityDataWidth;
 #endif // def USE_UART_DEBUG_COUNTERS
             }
-        } // end 1:1
-
-        else // 2:1
-        {
-            // Mask is used as a shift counter that is decremented by 2.
-            for (uint32_t NumBitsToShift = TxIntensityDataStartingMask - 2; 
-                 0 < NumBitsToShift; 
-                 NumBitsToShift -= 2)
+            else
             {
-                // convert the intensity data into UART data
-                enqueueUartData(Intensity2Uart[(IntensityValue >> NumBitsToShift) & 0x3]);
-#ifdef USE_UART_DEBUG_COUNTERS
-                IntensityBitsSent += 2;
-#endif // def USE_UART_DEBUG_COUNTERS
+                uint8_t UartData[UART_MAX_SLOTS_PER_INTENSITY];
+                size_t  NumUartSlots = TranslateIntensityValue(IntensityBlock[IntensityIndex], UartData);
+                for (size_t SlotIndex = 0; SlotIndex < NumUartSlots; ++SlotIndex)
+                {
+                    enqueueUartData(UartData[SlotIndex]);
+                }
             }
-            // handle the last two bits
-            enqueueUartData(Intensity2Uart[IntensityValue & 0x3]);
-#ifdef USE_UART_DEBUG_COUNTERS
-            IntensityBitsSent += 2;
-#endif    // def USE_UART_DEBUG_COUNTERS
-        } // end 2:1
+        } // end for each intensity in the block
 
         if (OutputUartConfig.NumInterIntensityBreakBits)
         {
@@ -860,6 +1002,9 @@ bool c_OutputUart::SetConfig(JsonObject &jsonConfig)
     bool response = false;
     response |= setFromJSON(tempDataPin, jsonConfig, CN_data_pin);
     response |= setFromJSON(OutputUartConfig.Baudrate, jsonConfig, CN_baudrate);
+#ifdef SUPPORT_UART_DMA
+    response |= setFromJSON(OutputUartConfig.UseDma, jsonConfig, CN_uartdma);
+#endif // def SUPPORT_UART_DMA
 
     OutputUartConfig.DataPin = gpio_num_t(tempDataPin);
 
@@ -880,6 +1025,75 @@ void c_OutputUart::SetIntensity2Uart(uint8_t value, UartDataBitTranslationId_t I
     Intensity2Uart[ID] = value;
 } // SetIntensity2Uart
 
+//----------------------------------------------------------------------------
+/*
+    Expand the bit pair (2:1) or single bit (1:1) translations into a table
+    indexed by a whole data byte so the ISR does one lookup per byte instead
+    of one per UART symbol. Only used when the data width is a multiple of
+    eight bits.
+*/
+void c_OutputUart::UpdateIntensity2UartWords()
+{
+    // DEBUG_START;
+
+    FreeIntensity2UartWords();
+
+    do // once
+    {
+        if ((OutputUartConfig.TranslateIntensityData == TranslateIntensityData_t::NoTranslation) ||
+            (0 != (OutputUartConfig.IntensityDataWidth & 0x7)))
+        {
+            break;
+        }
+
+        size_t NumSymbolsPerDataByte = (OutputUartConfig.TranslateIntensityData == TranslateIntensityData_t::OneToOne) ? 8 : 4;
+        NumUartWordsPerDataByte      = NumSymbolsPerDataByte / sizeof(uint32_t);
+
+        pIntensity2UartWords = (uint32_t *)malloc(256 * NumUartWordsPerDataByte * sizeof(uint32_t));
+        if (nullptr == pIntensity2UartWords)
+        {
+            // the ISR falls back to translating one symbol at a time
+            NumUartWordsPerDataByte = 0;
+            break;
+        }
+
+        for (uint32_t DataByte = 0; DataByte < 256; ++DataByte)
+        {
+            uint8_t Symbols[8];
+            for (size_t SymbolIndex = 0; SymbolIndex < NumSymbolsPerDataByte; ++SymbolIndex)
+            {
+                if (8 == NumSymbolsPerDataByte)
+                {
+                    Symbols[SymbolIndex] = Intensity2Uart[((DataByte >> (7 - SymbolIndex)) & 0x1) ? UartDataBitTranslationId_t::Uart_DATA_BIT_01_ID : UartDataBitTranslationId_t::Uart_DATA_BIT_00_ID];
+                }
+                else
+                {
+                    Symbols[SymbolIndex] = Intensity2Uart[(DataByte >> (6 - (SymbolIndex * 2))) & 0x3];
+                }
+            }
+            memcpy(&pIntensity2UartWords[DataByte * NumUartWordsPerDataByte], Symbols, NumSymbolsPerDataByte);
+        }
+
+    } while (false);
+
+    // DEBUG_END;
+} // UpdateIntensity2UartWords
+
+//----------------------------------------------------------------------------
+void c_OutputUart::FreeIntensity2UartWords()
+{
+    // DEBUG_START;
+
+    if (nullptr != pIntensity2UartWords)
+    {
+        free(pIntensity2UartWords);
+        pIntensity2UartWords = nullptr;
+    }
+    NumUartWordsPerDataByte = 0;
+
+    // DEBUG_END;
+} // FreeIntensity2UartWords
+
 //----------------------------------------------------------------------------
 void c_OutputUart::SetIntensityDataWidth()
 {
@@ -1040,25 +1254,41 @@ void c_OutputUart::StartNewFrame()
     IntensityBitsSent               = 0;
 #endif // def USE_UART_DEBUG_COUNTERS
 
-    // set up to send a new frame
-    GenerateBreak(OutputUartConfig.FrameStartBreakUS, OutputUartConfig.FrameStartMarkAfterBreakUS);
+    do // once
+    {
+#ifdef SUPPORT_UART_DMA
+        if (DmaIsActive && StartDmaFrame())
+        {
+            break;
+        }
+#endif // def SUPPORT_UART_DMA
 
-    // DEBUG_V();
+        if (nullptr != pTelemetry)
+        {
+            pTelemetry->WireStart ();
+        }
 
-    StartNewDataFrame();
-    // DEBUG_V();
+        // set up to send a new frame
+        GenerateBreak(OutputUartConfig.FrameStartBreakUS, OutputUartConfig.FrameStartMarkAfterBreakUS);
+
+        // DEBUG_V();
+
+        StartNewDataFrame();
+        // DEBUG_V();
 
 #if defined(ARDUINO_ARCH_ESP8266)
-    if (!IsUartTimerInUse())
-    {
+        if (!IsUartTimerInUse())
+        {
+            ISR_Handler_SendIntensityData();
+            EnableUartInterrupts();
+        }
+#else
         ISR_Handler_SendIntensityData();
         EnableUartInterrupts();
-    }
-#else
-    ISR_Handler_SendIntensityData();
-    EnableUartInterrupts();
 #endif // defined(ARDUINO_ARCH_ESP32)
 
+    } while (false);
+
     // DEBUG_END;
 
 } // StartNewFrame
@@ -1087,6 +1317,13 @@ void c_OutputUart::StartUart()
 
         enqueueUartData(0xff);
 
+#ifdef SUPPORT_UART_DMA
+        if (!OutputUartConfig.UseDma || !StartDma())
+        {
+            FreeDmaBuffers();
+        }
+#endif // def SUPPORT_UART_DMA
+
 #ifdef ARDUINO_ARCH_ESP8266
         // start processing the timer interrupts
         if (IsUartTimerInUse())
@@ -1106,6 +1343,9 @@ void c_OutputUart::TerminateUartOperation()
     // DEBUG_START;
     
     DisableUartInterrupts();
+#ifdef SUPPORT_UART_DMA
+    StopDma();
+#endif // def SUPPORT_UART_DMA
 
 #ifdef SUPPORT_UART_OUTPUT
     if (OutputUartConfig.ChannelId <= c_OutputMgr::e_OutputChannelIds::OutputChannelId_UART_LAST)
@@ -1156,4 +1396,360 @@ void c_OutputUart::TerminateUartOperation()
 
 } // TerminateUartOperation
 
+#ifdef SUPPORT_UART_DMA
+//----------------------------------------------------------------------------
+/*
+    Hand the UART TX FIFO to a UHCI DMA engine. UART1 uses UHCI0 and UART2
+    uses UHCI1. Returns false if this output has to stay on the FIFO
+    interrupt.
+*/
+bool c_OutputUart::StartDma()
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do // once
+    {
+        if (OutputUartConfig.NumInterIntensityBreakBits)
+        {
+            // every intensity value is followed by a break. Only the FIFO interrupt can do that
+            logcon(String(F("UART ")) + String(OutputUartConfig.UartId) + F(": DMA is not supported for this output type"));
+            break;
+        }
+
+        int IntrSource = 0;
+        if (UART_NUM_1 == OutputUartConfig.UartId)
+        {
+            pUhci      = &UHCI0;
+            IntrSource = ETS_UHCI0_INTR_SOURCE;
+            periph_module_enable(PERIPH_UHCI0_MODULE);
+        }
+        else if (UART_NUM_2 == OutputUartConfig.UartId)
+        {
+            pUhci      = &UHCI1;
+            IntrSource = ETS_UHCI1_INTR_SOURCE;
+            periph_module_enable(PERIPH_UHCI1_MODULE);
+        }
+        else
+        {
+            logcon(String(F("UART ")) + String(OutputUartConfig.UartId) + F(": DMA is only available on UART 1 and 2"));
+            break;
+        }
+
+        // reset the engine and connect it to our UART
+        pUhci->conf0.val               = 0;
+        pUhci->conf0.out_rst           = 1;
+        pUhci->conf0.ahbm_fifo_rst     = 1;
+        pUhci->conf0.ahbm_rst          = 1;
+        pUhci->conf0.out_rst           = 0;
+        pUhci->conf0.ahbm_fifo_rst     = 0;
+        pUhci->conf0.ahbm_rst          = 0;
+        pUhci->conf0.uart1_ce          = (UART_NUM_1 == OutputUartConfig.UartId);
+        pUhci->conf0.uart2_ce          = (UART_NUM_2 == OutputUartConfig.UartId);
+        pUhci->conf0.outdscr_burst_en  = 1;
+        pUhci->conf0.out_data_burst_en = 1;
+        pUhci->conf0.clk_en            = 1;
+
+        // raw data. No SLIP framing, headers, checksums or escapes
+        pUhci->conf1.val               = 0;
+        pUhci->escape_conf.val         = 0;
+
+        pUhci->int_ena.val             = 0;
+        pUhci->int_clr.val             = UINT32_MAX;
+
+        if (ESP_OK != esp_intr_alloc(IntrSource, ESP_INTR_FLAG_IRAM, uhci_intr_handler, this, &DmaIsrHandle))
+        {
+            logcon(String(F("UART ")) + String(OutputUartConfig.UartId) + F(": Could not allocate the DMA interrupt"));
+            StopDma();
+            break;
+        }
+        pUhci->int_ena.val             = UHCI_OUT_TOTAL_EOF_INT_ENA;
+
+        DmaFrameInProgress = false;
+        DmaIsActive        = true;
+        Response           = true;
+
+    } while (false);
+
+    // DEBUG_END;
+
+    return Response;
+
+} // StartDma
+
+//----------------------------------------------------------------------------
+void c_OutputUart::StopDma()
+{
+    // DEBUG_START;
+
+    if (nullptr != pUhci)
+    {
+        pUhci->dma_out_link.stop = 1;
+        pUhci->int_ena.val       = 0;
+        pUhci->int_clr.val       = UINT32_MAX;
+        pUhci->conf0.val         = 0;
+        periph_module_disable((&UHCI0 == pUhci) ? PERIPH_UHCI0_MODULE : PERIPH_UHCI1_MODULE);
+        pUhci = nullptr;
+    }
+
+    if (DmaIsrHandle)
+    {
+        esp_intr_free(DmaIsrHandle);
+        DmaIsrHandle = nullptr;
+    }
+
+    DmaFrameInProgress = false;
+    DmaIsActive        = false;
+
+    // DEBUG_END;
+} // StopDma
+
+//----------------------------------------------------------------------------
+void c_OutputUart::FreeDmaBuffers()
+{
+    // DEBUG_START;
+
+    for (auto & Buffer : DmaBuffers)
+    {
+        if (nullptr != Buffer.pData)
+        {
+            free(Buffer.pData);
+        }
+
+        if (nullptr != Buffer.pDescriptors)
+        {
+            free(Buffer.pDescriptors);
+        }
+
+        Buffer = DmaBuffer_t();
+    }
+
+    // DEBUG_END;
+} // FreeDmaBuffers
+
+//----------------------------------------------------------------------------
+bool c_OutputUart::GrowDmaBuffer(DmaBuffer_t & Buffer, size_t MinSize)
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do // once
+    {
+        // grow by at least half so a frame that keeps getting longer does not realloc every block
+        size_t NewSize = max(MinSize, Buffer.Size + (Buffer.Size / 2));
+        NewSize = (NewSize + 3) & ~size_t(3);
+
+        uint8_t * pNewData = (uint8_t *)heap_caps_realloc(Buffer.pData, NewSize, MALLOC_CAP_DMA);
+        if (nullptr == pNewData)
+        {
+            break;
+        }
+        Buffer.pData = pNewData;
+        Buffer.Size  = NewSize;
+
+        size_t NumDescriptors = (NewSize + (UART_DMA_MAX_DESCRIPTOR_SIZE - 1)) / UART_DMA_MAX_DESCRIPTOR_SIZE;
+        if (NumDescriptors > Buffer.NumDescriptors)
+        {
+            lldesc_t * pNewDescriptors = (lldesc_t *)heap_caps_realloc(Buffer.pDescriptors, NumDescriptors * sizeof(lldesc_t), MALLOC_CAP_DMA);
+            if (nullptr == pNewDescriptors)
+            {
+                break;
+            }
+            Buffer.pDescriptors   = pNewDescriptors;
+            Buffer.NumDescriptors = NumDescriptors;
+        }
+
+        // DEBUG_V(String("Buffer.Size: ") + String(Buffer.Size));
+        Response = true;
+
+    } while (false);
+
+    // DEBUG_END;
+
+    return Response;
+
+} // GrowDmaBuffer
+
+//----------------------------------------------------------------------------
+/*
+    Translate the whole frame into the buffer. This is the only time the
+    CPU touches the frame data. Called after StartNewDataFrame().
+*/
+bool c_OutputUart::EncodeDmaFrame(DmaBuffer_t & Buffer)
+{
+    // DEBUG_START;
+
+    bool     Response = true;
+    uint32_t IntensityBlock[UART_INTENSITY_BLOCK_SIZE];
+    size_t   BlockSizeInBytes = UART_INTENSITY_BLOCK_SIZE * NumUartSlotsPerIntensityValue;
+
+    if (0 == Buffer.Size)
+    {
+        // first frame. Start with the size of the channel data. Prepend / append data grows it later
+        size_t NumIntensities = 0;
+        if (nullptr != OutputUartConfig.pPixelDataSource)
+        {
+            NumIntensities = OutputUartConfig.pPixelDataSource->GetNumChannelsNeeded();
+        }
+#if defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
+        else
+        {
+            NumIntensities = OutputUartConfig.pSerialDataSource->GetNumChannelsNeeded();
+        }
+#endif // defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
+
+        Response = GrowDmaBuffer(Buffer, (NumIntensities * NumUartSlotsPerIntensityValue) + BlockSizeInBytes);
+    }
+
+    Buffer.Length = 0;
+    while (Response && MoreDataToSend())
+    {
+        if ((Buffer.Size - Buffer.Length) < BlockSizeInBytes)
+        {
+            Response = GrowDmaBuffer(Buffer, Buffer.Length + BlockSizeInBytes);
+            if (!Response)
+            {
+                break;
+            }
+        }
+
+        size_t NumIntensities = GetNextIntensityBlock(IntensityBlock, UART_INTENSITY_BLOCK_SIZE);
+        for (size_t IntensityIndex = 0; IntensityIndex < NumIntensities; ++IntensityIndex)
+        {
+#ifdef USE_UART_DEBUG_COUNTERS
+            IntensityValuesSent++;
+#endif // def USE_UART_DEBUG_COUNTERS
+            Buffer.Length += TranslateIntensityValue(IntensityBlock[IntensityIndex], &Buffer.pData[Buffer.Length]);
+        }
+    }
+
+    // DEBUG_END;
+
+    return Response;
+
+} // EncodeDmaFrame
+
+//----------------------------------------------------------------------------
+void c_OutputUart::LinkDmaDescriptors(DmaBuffer_t & Buffer)
+{
+    // DEBUG_START;
+
+    size_t Offset = 0;
+    for (size_t DescriptorIndex = 0; DescriptorIndex < Buffer.NumDescriptors; ++DescriptorIndex)
+    {
+        lldesc_t & Descriptor = Buffer.pDescriptors[DescriptorIndex];
+        size_t     NumBytes   = min(Buffer.Length - Offset, size_t(UART_DMA_MAX_DESCRIPTOR_SIZE));
+        bool       IsLast     = ((Offset + NumBytes) >= Buffer.Length);
+
+        Descriptor.size         = (NumBytes + 3) & ~size_t(3);
+        Descriptor.length       = NumBytes;
+        Descriptor.offset       = 0;
+        Descriptor.sosf         = 0;
+        Descriptor.eof          = IsLast;
+        Descriptor.owner        = 1;
+        Descriptor.buf          = &Buffer.pData[Offset];
+        Descriptor.qe.stqe_next = IsLast ? nullptr : &Buffer.pDescriptors[DescriptorIndex + 1];
+
+        Offset += NumBytes;
+        if (IsLast)
+        {
+            break;
+        }
+    }
+
+    // DEBUG_END;
+} // LinkDmaDescriptors
+
+//----------------------------------------------------------------------------
+/*
+    Translate the next frame into the back buffer, send the frame start
+    break and point the UHCI at the back buffer. Returns false if DMA had
+    to be turned off.
+*/
+bool c_OutputUart::StartDmaFrame()
+{
+    // DEBUG_START;
+
+    bool Response = false;
+
+    do // once
+    {
+        DmaBuffer_t & Buffer = DmaBuffers[DmaBackBufferIndex];
+
+        // the previous frame may still be going out of the other buffer
+        StartNewDataFrame();
+        if (!EncodeDmaFrame(Buffer))
+        {
+            logcon(String(F("UART ")) + String(OutputUartConfig.UartId) + F(": Not enough memory for the DMA buffers. Using the FIFO interrupt"));
+            StopDma();
+            FreeDmaBuffers();
+            break;
+        }
+        Response = true;
+
+        if (DmaFrameInProgress)
+        {
+            // the frame timer ran out before the previous frame was sent
+            pUhci->dma_out_link.stop = 1;
+            if (nullptr != pTelemetry)
+            {
+                ++pTelemetry->AbortedFrames;
+            }
+        }
+
+        if (0 == Buffer.Length)
+        {
+            break;
+        }
+        LinkDmaDescriptors(Buffer);
+
+        if (nullptr != pTelemetry)
+        {
+            pTelemetry->WireStart ();
+        }
+
+        GenerateBreak(OutputUartConfig.FrameStartBreakUS, OutputUartConfig.FrameStartMarkAfterBreakUS);
+
+        DmaFrameInProgress        = true;
+        pUhci->int_clr.val        = UINT32_MAX;
+        pUhci->dma_out_link.addr  = uint32_t(&Buffer.pDescriptors[0]) & UHCI_OUTLINK_ADDR_V;
+        pUhci->dma_out_link.start = 1;
+
+        DmaBackBufferIndex ^= 1;
+
+    } while (false);
+
+    // DEBUG_END;
+
+    return Response;
+
+} // StartDmaFrame
+
+//----------------------------------------------------------------------------
+void IRAM_ATTR c_OutputUart::ISR_DMA_Handler()
+{
+    uint32_t IsrStartCycle = c_OutputTelemetry::GetCycleCount ();
+    uint32_t IntStatus     = pUhci->int_st.val;
+    pUhci->int_clr.val     = IntStatus;
+
+    if (IntStatus & UHCI_OUT_TOTAL_EOF_INT_ST)
+    {
+        // the last byte is in the UART FIFO
+        DmaFrameInProgress = false;
+#ifdef USE_UART_DEBUG_COUNTERS
+        FrameEndISRcounter++;
+#endif // def USE_UART_DEBUG_COUNTERS
+
+        if (nullptr != pTelemetry)
+        {
+            pTelemetry->WireDone ();
+            pTelemetry->AddIsrCycles (c_OutputTelemetry::GetCycleCount () - IsrStartCycle);
+        }
+    }
+
+} // ISR_DMA_Handler
+#endif // def SUPPORT_UART_DMA
+
 #endif // def SUPPORT_UART_OUTPUT
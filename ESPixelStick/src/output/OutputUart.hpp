@@ -25,6 +25,13 @@
 #   include <soc/uart_reg.h>
 #   include <driver/uart.h>
 #   include <driver/gpio.h>
+#   if CONFIG_IDF_TARGET_ESP32
+        // UART1 and UART2 can be fed by the UHCI DMA engines
+#       define SUPPORT_UART_DMA
+#       include <soc/uhci_struct.h>
+#       include <soc/uhci_reg.h>
+#       include <esp32/rom/lldesc.h>
+#   endif // CONFIG_IDF_TARGET_ESP32
 #endif
 
 #include "OutputPixel.hpp"
@@ -48,6 +55,10 @@ public:
 // TX FIFO trigger level. WS2811 40 bytes gives 100us before the FIFO goes empty
 // We need to fill the FIFO at a rate faster than 0.3us per byte (1.2us/pixel)
 #define DEFAULT_UART_FIFO_TRIGGER_LEVEL (17)
+// Max number of intensity values pulled from the data source per call
+#define UART_INTENSITY_BLOCK_SIZE (32)
+// Max number of UART bytes one intensity value can translate into (1:1 with 32 bit data)
+#define UART_MAX_SLOTS_PER_INTENSITY (32)
 
     enum TranslateIntensityData_t
     {
@@ -91,6 +102,7 @@ public:
         uint16_t                    NumInterIntensityBreakBits      = 0;
         uint16_t                    NumInterIntensityMABbits        = 0;
         bool                        TriggerIsrExternally            = false;
+        bool                        UseDma                          = false; // ESP32 only. Ignored if the output needs inter intensity breaks
         const CitudsArray_t        *CitudsArray                     = nullptr;
 
 #if defined(SUPPORT_OutputType_DMX) || defined(SUPPORT_OutputType_Serial) || defined(SUPPORT_OutputType_Renard)
@@ -111,6 +123,9 @@ public:
 
     void IRAM_ATTR ISR_UART_Handler();
     void IRAM_ATTR ISR_Handler_SendIntensityData();
+#ifdef SUPPORT_UART_DMA
+    void IRAM_ATTR ISR_DMA_Handler();
+#endif // def SUPPORT_UART_DMA
 
 private:
     void StartUart              ();
@@ -124,10 +139,14 @@ private:
     void GenerateBreak          (uint32_t DurationInUs, uint32_t MarkDurationInUs);
     void SetIntensityDataWidth  ();
     void SetIntensity2Uart      (uint8_t value, UartDataBitTranslationId_t ID);
+    void UpdateIntensity2UartWords ();
+    void FreeIntensity2UartWords   ();
 
     OutputUartConfig_t OutputUartConfig;
 
     uint8_t Intensity2Uart[UartDataBitTranslationId_t::Uart_LIST_END];
+    uint32_t      * pIntensity2UartWords            = nullptr;  ///< 256 entries. UART bytes for one data byte, first byte in the low bits
+    size_t          NumUartWordsPerDataByte         = 0;        ///< 1 for 2:1, 2 for 1:1
     bool            OutputIsPaused                  = false;
     uint32_t        LastFrameStartTime              = 0;
     uint32_t        FrameMinDurationInMicroSec      = 25000;
@@ -136,20 +155,54 @@ private:
     size_t          NumUartSlotsPerIntensityValue   = 1;
     uint32_t        MarkAfterInterintensityBreakBitCCOUNT          = 0;
     uint32_t        ActiveIsrMask                   = 0;
+    c_OutputTelemetry * pTelemetry                  = nullptr;   ///< Belongs to the data source
 #if defined(ARDUINO_ARCH_ESP32)
     intr_handle_t   IsrHandle                       = nullptr;
 #endif // defined(ARDUINO_ARCH_ESP32)
 
     bool     IRAM_ATTR      MoreDataToSend();
-    uint32_t IRAM_ATTR      GetNextIntensityToSend();
+    size_t   IRAM_ATTR      GetNextIntensityBlock(uint32_t * pTarget, size_t MaxIntensities);
     void     IRAM_ATTR      StartNewDataFrame();
     uint32_t IRAM_ATTR      getUartFifoLength();
     void     IRAM_ATTR      enqueueUartData(uint8_t value);
+    inline void IRAM_ATTR   enqueueUartWord(uint32_t value);
+    inline size_t IRAM_ATTR TranslateIntensityValue(uint32_t IntensityValue, uint8_t * pTarget); ///< Returns the number of UART bytes written
     void                    CalculateEnableUartInterruptFlags();
     inline void IRAM_ATTR   EnableUartInterrupts();
     inline void IRAM_ATTR   ClearUartInterrupts();
     inline void IRAM_ATTR   DisableUartInterrupts();
 
+#ifdef SUPPORT_UART_DMA
+// Descriptor length field is 12 bits. Keep the chunks word aligned
+#define UART_DMA_MAX_DESCRIPTOR_SIZE (4092)
+
+    // One translated frame plus the descriptor chain that hands it to the UHCI
+    struct DmaBuffer_t
+    {
+        uint8_t   * pData           = nullptr;  ///< Internal DMA capable RAM
+        size_t      Size            = 0;        ///< Allocated bytes
+        size_t      Length          = 0;        ///< Bytes in the frame held by this buffer
+        lldesc_t  * pDescriptors    = nullptr;
+        size_t      NumDescriptors  = 0;
+    };
+
+    // the next frame is translated into one buffer while the other one is on the wire
+    DmaBuffer_t     DmaBuffers[2];
+    size_t          DmaBackBufferIndex              = 0;
+    uhci_dev_t    * pUhci                           = nullptr;
+    intr_handle_t   DmaIsrHandle                    = nullptr;
+    bool            DmaIsActive                     = false;
+    volatile bool   DmaFrameInProgress              = false;
+
+    bool            StartDma                ();
+    void            StopDma                 ();
+    void            FreeDmaBuffers          ();
+    bool            GrowDmaBuffer           (DmaBuffer_t & Buffer, size_t MinSize);
+    bool            EncodeDmaFrame          (DmaBuffer_t & Buffer);
+    void            LinkDmaDescriptors      (DmaBuffer_t & Buffer);
+    bool            StartDmaFrame           ();
+#endif // def SUPPORT_UART_DMA
+
 // #define USE_UART_DEBUG_COUNTERS
 #ifdef USE_UART_DEBUG_COUNTERS
     // debug counters
@@ -70,7 +70,7 @@ void c_OutputWS2801::SetOutputBufferSize (uint16_t NumChannelsAvailable)
     c_OutputPixel::SetOutputBufferSize (NumChannelsAvailable);
 
     // Calculate our refresh time
-    SetFrameDurration (((1.0 / float (WS2801_BIT_RATE)) * MicroSecondsInASecond), BlockSize, BlockDelay);
+    SetFrameDurration (((1.0 / float (BitRate)) * MicroSecondsInASecond), BlockSize, BlockDelay);
 
     // DEBUG_END;
 
@@ -92,7 +92,7 @@ bool c_OutputWS2801::SetConfig (ArduinoJson::JsonObject& jsonConfig)
     bool response = c_OutputPixel::SetConfig (jsonConfig);
 
     // Calculate our refresh time
-    SetFrameDurration (((1.0 / float (WS2801_BIT_RATE)) * MicroSecondsInASecond), BlockSize, BlockDelay);
+    SetFrameDurration (((1.0 / float (BitRate)) * MicroSecondsInASecond), BlockSize, BlockDelay);
 
     // DEBUG_END;
     return response;
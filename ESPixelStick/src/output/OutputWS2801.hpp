@@ -47,6 +47,7 @@ protected:
 #define WS2801_MICRO_SEC_PER_INTENSITY  int(((1.0/float(WS2801_BIT_RATE)) * WS2801_BITS_PER_INTENSITY))
 #define WS2801_MIN_IDLE_TIME_US         500
     uint16_t    BlockSize = 1;
+    uint32_t    BitRate = WS2801_BIT_RATE;     ///< Clock of the driver sending the data
     float       BlockDelay = 0;
 
 }; // c_OutputWS2801
@@ -67,6 +67,7 @@ void c_OutputWS2801Spi::GetConfig (ArduinoJson::JsonObject& jsonConfig)
     // DEBUG_START;
 
     c_OutputWS2801::GetConfig (jsonConfig);
+    Spi.GetConfig (jsonConfig);
 
     jsonConfig[CN_clock_pin] = DEFAULT_SPI_CLOCK_GPIO;
 
@@ -78,6 +79,12 @@ bool c_OutputWS2801Spi::SetConfig (ArduinoJson::JsonObject& jsonConfig)
 {
     // DEBUG_START;
 
+    Spi.SetConfig (jsonConfig);
+
+    // the frame timing follows the mode and clock of the SPI driver
+    BitRate   = Spi.GetClockHz ();
+    BlockSize = Spi.GetBlockSize ();
+
     bool response = c_OutputWS2801::SetConfig (jsonConfig);
 
     // DEBUG_END;
@@ -85,6 +92,17 @@ bool c_OutputWS2801Spi::SetConfig (ArduinoJson::JsonObject& jsonConfig)
 
 } // GetStatus
 
+//----------------------------------------------------------------------------
+void c_OutputWS2801Spi::GetStatus (ArduinoJson::JsonObject& jsonStatus)
+{
+    // DEBUG_START;
+
+    c_OutputWS2801::GetStatus (jsonStatus);
+    Spi.GetStatus (jsonStatus);
+
+    // DEBUG_END;
+} // GetStatus
+
 //----------------------------------------------------------------------------
 void c_OutputWS2801Spi::Render ()
 {
@@ -92,10 +110,8 @@ void c_OutputWS2801Spi::Render ()
 
     if (canRefresh ())
     {
-        if (Spi.Render ())
-            {
-            ReportNewFrame ();
-            }
+        // the pixel data source reports the new frame
+        Spi.Render ();
     }
 
     // DEBUG_END;
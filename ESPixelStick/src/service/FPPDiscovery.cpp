@@ -403,7 +403,10 @@ void c_FPPDiscovery::ProcessBlankPacket ()
 
     if (IsEnabled)
     {
+        OutputMgr.LockBuffer ();
         memset (OutputMgr.GetBufferAddress(), 0x0, OutputMgr.GetBufferUsedSize ());
+        OutputMgr.MarkBufferDirty ();
+        OutputMgr.UnlockBuffer ();
     }
     // DEBUG_END;
 } // ProcessBlankPacket
@@ -20,6 +20,9 @@ var pingTimer;
 var pongTimer;
 var IsDocumentHidden = false;
 
+// output settings that only some drivers have. Not shown or saved when the driver does not report them
+var OptionalOutputSettings = ["uartdma", "spiframe", "spimhz"];
+
 // Drawing canvas - move to diagnostics
 var canvas = document.getElementById("canvas");
 var ctx = canvas.getContext("2d");
@@ -603,6 +606,13 @@ function ProcessModeConfigurationDataRelay(RelayConfig)
 
     let ChannelConfigs = RelayConfig.channels;
 
+    if ({}.hasOwnProperty.call(RelayConfig, "pwmfade")) {
+        $("#pwmfade_row").removeClass("hidden");
+    }
+    else {
+        $("#pwmfade_row").addClass("hidden");
+    }
+
     let HasPwmFrequency = false;
     if ({}.hasOwnProperty.call(ChannelConfigs[0], "Frequency")) {
         HasPwmFrequency = true;
@@ -665,6 +675,8 @@ function ProcessModeConfigurationDataServoPCA9685(ServoConfig)
 
     let ChannelConfigs = ServoConfig.channels;
 
+    $('#i2caddrs').val(ServoConfig.i2caddrs.map(function (Address) { return '0x' + Address.toString(16); }).join(', '));
+
     // add as many rows as we need
     for (let CurrentRowId = 1; CurrentRowId <= ChannelConfigs.length; CurrentRowId++) {
         // console.log("CurrentRowId = " + CurrentRowId);
@@ -725,6 +737,20 @@ function ProcessInputConfig()
 
 } // ProcessInputConfig
 
+function ProcessOutputConfig()
+{
+    // only builds with RMT outputs report the RMT settings
+    let HasRmtConfig = {}.hasOwnProperty.call(Output_Config, "rmtstartmode");
+    $('.rmtconfig').toggleClass('hidden', !HasRmtConfig);
+    if (HasRmtConfig)
+    {
+        $("#rmtstartmode").val(Output_Config.rmtstartmode);
+        $("#rmtmaxblocks").val(Output_Config.rmtmaxblocks);
+        $("#rmtpreencode").prop("checked", Output_Config.rmtpreencode);
+    }
+
+} // ProcessOutputConfig
+
 function ProcessModeConfigurationData(channelId, ChannelType, JsonConfig )
 {
     // console.info("ProcessModeConfigurationData: Start");
@@ -764,6 +790,11 @@ function ProcessModeConfigurationData(channelId, ChannelType, JsonConfig )
     elementids.forEach(function (elementid)
     {
         let SelectedElement = modeControlName + ' #' + elementid;
+        if (OptionalOutputSettings.includes(elementid) && !{}.hasOwnProperty.call(channelConfig, elementid))
+        {
+            // keep the default so the hidden field still validates
+            return;
+        }
         if ($(SelectedElement).is(':checkbox'))
         {
             $(SelectedElement).prop('checked', channelConfig[elementid]);
@@ -774,6 +805,11 @@ function ProcessModeConfigurationData(channelId, ChannelType, JsonConfig )
         }
     });
 
+    // only the UART outputs that can use DMA report uartdma
+    $(modeControlName + ' .uartdma').toggleClass('hidden', !{}.hasOwnProperty.call(channelConfig, "uartdma"));
+    // only the SPI outputs report their SPI settings
+    $(modeControlName + ' .spiconfig').toggleClass('hidden', !{}.hasOwnProperty.call(channelConfig, "spimhz"));
+
     if ("fpp_remote" === ChannelTypeName)
     {
         if (null !== Fseq_File_List)
@@ -816,6 +852,7 @@ function ProcessReceivedJsonConfigMessage(JsonConfigData)
         // save the config for later use.
         Output_Config = JsonConfigData.output_config;
         CreateOptionsFromConfig("output", Output_Config);
+        ProcessOutputConfig();
     }
 
     // is this an input config?
@@ -1100,6 +1137,9 @@ function ExtractChannelConfigFromHtmlPage(JsonConfig, SectionName)
         if ((ChannelConfig.type === "Relay") && ($("#relaychannelconfigurationtable").length))
         {
             ChannelConfig.updateinterval = parseInt($('#updateinterval').val(), 10);
+            if ({}.hasOwnProperty.call(ChannelConfig, "pwmfade")) {
+                ChannelConfig.pwmfade = parseInt($('#pwmfade').val(), 10);
+            }
             $.each(ChannelConfig.channels, function (i, CurrentChannelConfig) {
                 // console.info("Current Channel Id = " + CurrentChannelConfig.id);
                 let currentChannelRowId = CurrentChannelConfig.id + 1;
@@ -1109,7 +1149,7 @@ function ExtractChannelConfigFromHtmlPage(JsonConfig, SectionName)
                 CurrentChannelConfig.gid  = parseInt($('#gpioId_' + (currentChannelRowId)).val(), 10);
                 CurrentChannelConfig.trig = parseInt($('#threshhold_' + (currentChannelRowId)).val(), 10);
 
-                if ({}.hasOwnProperty.call(ChannelConfig, "Frequency")) {
+                if ({}.hasOwnProperty.call(CurrentChannelConfig, "Frequency")) {
                     CurrentChannelConfig.Frequency = parseInt($('#Frequency_' + (currentChannelRowId)).val(), 10);
 				}
             });
@@ -1117,6 +1157,9 @@ function ExtractChannelConfigFromHtmlPage(JsonConfig, SectionName)
         else if ((ChannelConfig.type === "Servo PCA9685") && ($("#servo_pca9685channelconfigurationtable").length))
         {
             ChannelConfig.updateinterval = parseInt($('#updateinterval').val(), 10);
+            ChannelConfig.i2ckhz         = parseInt($('#i2ckhz').val(), 10);
+            // addresses are entered as a list like "0x40, 0x41"
+            ChannelConfig.i2caddrs       = $('#i2caddrs').val().split(',').map(function (Address) { return parseInt(Address.trim()); }).filter(function (Address) { return !isNaN(Address); });
             $.each(ChannelConfig.channels, function (i, CurrentChannelConfig) {
                 // console.info("Current Channel Id = " + CurrentChannelConfig.id);
                 let currentChannelRowId  = CurrentChannelConfig.id + 1;
@@ -1135,6 +1178,10 @@ function ExtractChannelConfigFromHtmlPage(JsonConfig, SectionName)
         {
             elementids.forEach(function (elementid) {
                 let SelectedElement = modeControlName + ' #' + elementid;
+                if (OptionalOutputSettings.includes(elementid) && !{}.hasOwnProperty.call(ChannelConfig, elementid)) {
+                    // the output does not have this setting
+                    return;
+                }
                 if ($(SelectedElement).is(':checkbox')) {
                     ChannelConfig[elementid] = $(SelectedElement).prop('checked');
                 }
@@ -1184,6 +1231,12 @@ function submitDeviceConfig()
     Input_Config.ecb.polarity = $("#ecb_polarity").val();
 
     ExtractChannelConfigFromHtmlPage(Output_Config.channels, "output");
+    if ({}.hasOwnProperty.call(Output_Config, "rmtstartmode"))
+    {
+        Output_Config.rmtstartmode = parseInt($("#rmtstartmode").val(), 10);
+        Output_Config.rmtmaxblocks = parseInt($("#rmtmaxblocks").val(), 10);
+        Output_Config.rmtpreencode = $("#rmtpreencode").is(':checked');
+    }
 
     submitNetworkConfig();
     wsEnqueue(JSON.stringify({ 'cmd': { 'set': { 'input':  { 'input_config':  Input_Config  } } } }));
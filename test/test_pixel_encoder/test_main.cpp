@@ -0,0 +1,535 @@
+/*
+* test_main.cpp - Host benchmark of the pixel data encoders
+*
+* Project: ESPixelStick - An ESP8266 / ESP32 and E1.31 based pixel driver
+* Copyright (c) 2026 ESPixelStick contributors
+*
+*  This program is provided free for you to use in any way that you wish,
+*  subject to the laws and regulations where you are using it.  Due diligence
+*  is strongly suggested before using this code.  Please give credit where due.
+*
+*  The Author makes no warranty of any kind, express or implied, with regard
+*  to this program or the documentation contained in this document.  The
+*  Author shall not be liable in any event for incidental or consequential
+*  damages in connection with, or arising out of, the furnishing, performance
+*  or use of these programs.
+*
+*   Run with: pio test -e native -f test_pixel_encoder
+*
+*   c_OutputPixel needs the Arduino core so the pixel part of the generic
+*   state machine (ISR_GetNextIntensityToSend, GetIntensityData and
+*   PixelDataComplete) and the specialized EncodePixelData variants are
+*   copied here from OutputPixel.cpp. Keep them in step with it. AdjustAtIsr
+*   selects the ADJUST_INTENSITY_AT_ISR (ESP8266) code paths. The times are
+*   host times. They show the relative cost of the encoders, not the cycles
+*   they take on the target.
+*
+*/
+
+#include <unity.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#define BENCH_NUM_PIXELS        680
+#define BENCH_NUM_FRAMES        2000
+#define BENCH_BLOCK_SIZE        8       // RMT_INTENSITY_BLOCK_SIZE for one RMT memory block
+#define MAX_BYTES_PER_PIXEL     4
+
+//----------------------------------------------------------------------------
+// The parts of c_OutputPixel that encode the pixel data
+template <bool AdjustAtIsr>
+class c_PixelEncoder
+{
+public:
+    enum FrameState_t
+    {
+        FrameSendPixels,
+        FrameDone
+    };
+
+    typedef size_t (c_PixelEncoder::*PixelEncoder32_t)(uint32_t * pTarget, size_t MaxIntensities);
+
+    void SetConfig (uint8_t * pFrame, size_t PixelCount, size_t BytesPerPixel, size_t GroupSize, size_t ZigSize, bool Invert)
+    {
+        pFrameBuffer              = pFrame;
+        pixel_count               = PixelCount;
+        NumIntensityBytesPerPixel = BytesPerPixel;
+        PixelGroupSize            = GroupSize;
+        InvertData                = Invert;
+        ZigPixelCount             = (2 > ZigSize) ? pixel_count + 1 : ZigSize + 1;
+        ZagPixelCount             = (2 > ZigSize) ? pixel_count + 1 : ZigSize + 1;
+        AdjustedBrightness        = 200;
+
+        // grb(w)
+        uint8_t Offsets[] = { 1, 0, 2, 3 };
+        memcpy (ColorOffsets, Offsets, sizeof (ColorOffsets));
+
+        for (uint32_t index = 0; index < 256; ++index)
+        {
+            gamma_table[index] = uint8_t ((index * index) >> 8);
+        }
+
+        SelectPixelEncoders ((1 < ZigSize) && (ZigSize < PixelCount), (1 < GroupSize));
+    }
+
+    void StartNewFrame ()
+    {
+        NextPixelToSend              = pFrameBuffer;
+        ZigPixelCurrentCount         = 1;
+        ZagPixelCurrentCount         = 0;
+        SentPixelsCount              = 0;
+        PixelIntensityCurrentIndex   = 0;
+        PixelGroupSizeCurrentCount   = 0;
+        FrameState                   = FrameSendPixels;
+    }
+
+    bool MoreDataToSend () { return FrameDone != FrameState; }
+
+    // ISR_GetNextIntensityToSend for a frame with no prepend / append data.
+    // The transports call it from another file so it is never inlined there
+    __attribute__((noinline)) uint32_t GetNextIntensityToSend ()
+    {
+        uint32_t response = 0x00;
+
+        switch (FrameState)
+        {
+            case FrameSendPixels:
+            {
+                // pixel prepend goes here
+                if (PixelPrependDataCurrentIndex < PixelPrependDataSize)
+                {
+                    response = 0;
+                    break;
+                }
+                response = GetIntensityData ();
+                break;
+            }
+
+            case FrameDone:
+            default:
+            {
+                break;
+            }
+        }
+
+        if (InvertData)
+        {
+            response = ~response;
+        }
+
+        return response;
+    }
+
+    uint32_t GetIntensityData ()
+    {
+        uint32_t response = 0;
+
+        do // once
+        {
+            if (AdjustAtIsr)
+            {
+                response = (NextPixelToSend[ColorOffsets[PixelIntensityCurrentIndex]]);
+                response = gamma_table[response];
+                response = uint8_t ((uint32_t (response) * AdjustedBrightness) >> 8);
+
+                if (++PixelIntensityCurrentIndex < NumIntensityBytesPerPixel)
+                {
+                    break;
+                }
+
+                PixelIntensityCurrentIndex = 0;
+                PixelPrependDataCurrentIndex = 0;
+
+                if (++PixelGroupSizeCurrentCount < PixelGroupSize)
+                {
+                    break;
+                }
+                PixelGroupSizeCurrentCount = 0;
+
+                ++SentPixelsCount;
+                if (SentPixelsCount >= pixel_count)
+                {
+                    PixelDataComplete ();
+                    break;
+                }
+
+                if (++ZigPixelCurrentCount < ZigPixelCount)
+                {
+                    NextPixelToSend += NumIntensityBytesPerPixel;
+                    break;
+                }
+
+                if (0 == ZagPixelCurrentCount)
+                {
+                    NextPixelToSend += NumIntensityBytesPerPixel * (ZagPixelCount);
+                }
+
+                if (++ZagPixelCurrentCount < ZagPixelCount)
+                {
+                    NextPixelToSend -= NumIntensityBytesPerPixel;
+                    break;
+                }
+
+                NextPixelToSend += NumIntensityBytesPerPixel * (ZagPixelCount - 1);
+
+                ZigPixelCurrentCount = 1;
+                ZagPixelCurrentCount = 0;
+                break;
+            }
+
+            response = NextPixelToSend[PixelIntensityCurrentIndex];
+
+            if (++PixelIntensityCurrentIndex < NumIntensityBytesPerPixel)
+            {
+                break;
+            }
+
+            PixelIntensityCurrentIndex = 0;
+            PixelPrependDataCurrentIndex = 0;
+
+            if (++PixelGroupSizeCurrentCount < PixelGroupSize)
+            {
+                break;
+            }
+            PixelGroupSizeCurrentCount = 0;
+
+            if (++SentPixelsCount >= pixel_count)
+            {
+                PixelDataComplete ();
+                break;
+            }
+
+            NextPixelToSend += NumIntensityBytesPerPixel;
+
+        } while (false);
+
+        return response;
+    }
+
+    void PixelDataComplete ()
+    {
+        FrameState = FrameDone;
+    }
+
+    template <size_t BytesPerPixel, bool ZigZag, bool Grouping>
+    size_t EncodePixelData (uint32_t * pTarget, size_t MaxIntensities)
+    {
+        size_t    NumIntensitiesWritten = 0;
+        uint32_t  InvertMask            = (InvertData) ? uint32_t (-1) : 0;
+        uint32_t  Brightness            = AdjustedBrightness;
+        uint8_t * pPixel                = NextPixelToSend;
+        size_t    ColorIndex            = PixelIntensityCurrentIndex;
+        uint8_t   Offsets[BytesPerPixel];
+
+        for (size_t index = 0; index < BytesPerPixel; ++index)
+        {
+            Offsets[index] = (AdjustAtIsr) ? ColorOffsets[index] : index;
+        }
+
+        while (NumIntensitiesWritten < MaxIntensities)
+        {
+            if ((0 == ColorIndex) && (BytesPerPixel <= (MaxIntensities - NumIntensitiesWritten)))
+            {
+                for (size_t index = 0; index < BytesPerPixel; ++index)
+                {
+                    uint32_t Intensity = (AdjustAtIsr) ?
+                                         uint8_t ((uint32_t (gamma_table[pPixel[Offsets[index]]]) * Brightness) >> 8) :
+                                         pPixel[Offsets[index]];
+                    pTarget[NumIntensitiesWritten++] = Intensity ^ InvertMask;
+                }
+            }
+            else
+            {
+                uint32_t Intensity = (AdjustAtIsr) ?
+                                     uint8_t ((uint32_t (gamma_table[pPixel[Offsets[ColorIndex]]]) * Brightness) >> 8) :
+                                     pPixel[Offsets[ColorIndex]];
+                pTarget[NumIntensitiesWritten++] = Intensity ^ InvertMask;
+                if (++ColorIndex < BytesPerPixel)
+                {
+                    continue;
+                }
+            }
+            ColorIndex = 0;
+
+            if (Grouping)
+            {
+                if (++PixelGroupSizeCurrentCount < PixelGroupSize)
+                {
+                    continue;
+                }
+                PixelGroupSizeCurrentCount = 0;
+            }
+
+            if (++SentPixelsCount >= pixel_count)
+            {
+                PixelDataComplete ();
+                break;
+            }
+
+            if (!ZigZag)
+            {
+                pPixel += BytesPerPixel;
+                continue;
+            }
+
+            if (++ZigPixelCurrentCount < ZigPixelCount)
+            {
+                pPixel += BytesPerPixel;
+                continue;
+            }
+
+            if (0 == ZagPixelCurrentCount)
+            {
+                pPixel += BytesPerPixel * ZagPixelCount;
+            }
+
+            if (++ZagPixelCurrentCount < ZagPixelCount)
+            {
+                pPixel -= BytesPerPixel;
+                continue;
+            }
+
+            pPixel += BytesPerPixel * (ZagPixelCount - 1);
+
+            ZigPixelCurrentCount = 1;
+            ZagPixelCurrentCount = 0;
+        }
+
+        NextPixelToSend            = pPixel;
+        PixelIntensityCurrentIndex = ColorIndex;
+
+        return NumIntensitiesWritten;
+    }
+
+    template <size_t BytesPerPixel>
+    void SetPixelEncoders (bool ZigZag, bool Grouping)
+    {
+        if (AdjustAtIsr && ZigZag && Grouping)
+        {
+            pPixelEncoder32 = &c_PixelEncoder::EncodePixelData<BytesPerPixel, true,  true>;
+        }
+        else if (AdjustAtIsr && ZigZag)
+        {
+            pPixelEncoder32 = &c_PixelEncoder::EncodePixelData<BytesPerPixel, true,  false>;
+        }
+        else if (Grouping)
+        {
+            pPixelEncoder32 = &c_PixelEncoder::EncodePixelData<BytesPerPixel, false, true>;
+        }
+        else
+        {
+            pPixelEncoder32 = &c_PixelEncoder::EncodePixelData<BytesPerPixel, false, false>;
+        }
+    }
+
+    void SelectPixelEncoders (bool ZigZag, bool Grouping)
+    {
+        pPixelEncoder32 = nullptr;
+
+        if (3 == NumIntensityBytesPerPixel)
+        {
+            SetPixelEncoders<3> (ZigZag, Grouping);
+        }
+        else if (4 == NumIntensityBytesPerPixel)
+        {
+            SetPixelEncoders<4> (ZigZag, Grouping);
+        }
+    }
+
+    // EncodeBlock for a frame with no prepend / append data
+    __attribute__((noinline)) size_t EncodeBlock (uint32_t * pTarget, size_t MaxIntensities)
+    {
+        size_t NumIntensitiesWritten = 0;
+
+        while ((NumIntensitiesWritten < MaxIntensities) && (FrameDone != FrameState))
+        {
+            NumIntensitiesWritten += (this->*pPixelEncoder32)(&pTarget[NumIntensitiesWritten], (MaxIntensities - NumIntensitiesWritten));
+        }
+
+        return NumIntensitiesWritten;
+    }
+
+private:
+    FrameState_t     FrameState                   = FrameDone;
+    uint8_t        * pFrameBuffer                 = nullptr;
+    uint8_t        * NextPixelToSend              = nullptr;
+    size_t           pixel_count                  = 0;
+    size_t           NumIntensityBytesPerPixel    = 3;
+    size_t           PixelIntensityCurrentIndex   = 0;
+    size_t           PixelPrependDataCurrentIndex = 0;
+    size_t           PixelPrependDataSize         = 0;
+    size_t           PixelGroupSize               = 1;
+    size_t           PixelGroupSizeCurrentCount   = 0;
+    size_t           SentPixelsCount              = 0;
+    size_t           ZigPixelCount                = 0;
+    size_t           ZigPixelCurrentCount         = 1;
+    size_t           ZagPixelCount                = 0;
+    size_t           ZagPixelCurrentCount         = 0;
+    bool             InvertData                   = false;
+    uint32_t         AdjustedBrightness           = 256;
+    uint8_t          ColorOffsets[MAX_BYTES_PER_PIXEL];
+    uint8_t          gamma_table[256];
+    PixelEncoder32_t pPixelEncoder32              = nullptr;
+
+}; // c_PixelEncoder
+
+static uint8_t  FrameData[BENCH_NUM_PIXELS * MAX_BYTES_PER_PIXEL];
+static uint32_t GenericOutput[BENCH_NUM_PIXELS * MAX_BYTES_PER_PIXEL * 2];
+static uint32_t SpecializedOutput[BENCH_NUM_PIXELS * MAX_BYTES_PER_PIXEL * 2];
+volatile uint32_t BenchChecksum = 0;
+
+//----------------------------------------------------------------------------
+void setUp ()
+{
+    // the same pseudo random frame every run
+    uint32_t Seed = 0x12345678;
+    for (auto & Intensity : FrameData)
+    {
+        Seed = (Seed * 1103515245) + 12345;
+        Intensity = uint8_t (Seed >> 16);
+    }
+} // setUp
+
+//----------------------------------------------------------------------------
+void tearDown ()
+{
+} // tearDown
+
+//----------------------------------------------------------------------------
+/*
+    The specialized encoder has to produce the same frame as the state
+    machine, whatever size blocks the transport asks for.
+*/
+template <bool AdjustAtIsr>
+static void CheckSameOutput (size_t BytesPerPixel, size_t GroupSize, size_t ZigSize, bool Invert, size_t BlockSize)
+{
+    size_t NumPixels = 100;
+
+    c_PixelEncoder<AdjustAtIsr> Generic;
+    Generic.SetConfig (FrameData, NumPixels, BytesPerPixel, GroupSize, ZigSize, Invert);
+    Generic.StartNewFrame ();
+    size_t NumGeneric = 0;
+    while (Generic.MoreDataToSend ())
+    {
+        GenericOutput[NumGeneric++] = Generic.GetNextIntensityToSend ();
+    }
+
+    c_PixelEncoder<AdjustAtIsr> Specialized;
+    Specialized.SetConfig (FrameData, NumPixels, BytesPerPixel, GroupSize, ZigSize, Invert);
+    Specialized.StartNewFrame ();
+    size_t NumSpecialized = 0;
+    while (Specialized.MoreDataToSend ())
+    {
+        NumSpecialized += Specialized.EncodeBlock (&SpecializedOutput[NumSpecialized], BlockSize);
+    }
+
+    TEST_ASSERT_EQUAL (NumPixels * BytesPerPixel * GroupSize, NumGeneric);
+    TEST_ASSERT_EQUAL (NumGeneric, NumSpecialized);
+    for (size_t index = 0; index < NumGeneric; ++index)
+    {
+        TEST_ASSERT_EQUAL_HEX32 (GenericOutput[index], SpecializedOutput[index]);
+    }
+} // CheckSameOutput
+
+//----------------------------------------------------------------------------
+static void test_same_output_esp32 ()
+{
+    CheckSameOutput<false> (3, 1, 0, false, BENCH_BLOCK_SIZE);
+    CheckSameOutput<false> (3, 1, 0, true,  7);
+    CheckSameOutput<false> (4, 1, 0, false, 7);
+    CheckSameOutput<false> (3, 3, 0, false, 5);
+    CheckSameOutput<false> (4, 2, 0, true,  BENCH_BLOCK_SIZE);
+} // test_same_output_esp32
+
+//----------------------------------------------------------------------------
+static void test_same_output_esp8266 ()
+{
+    CheckSameOutput<true> (3, 1, 0,  false, BENCH_BLOCK_SIZE);
+    CheckSameOutput<true> (4, 1, 0,  true,  7);
+    CheckSameOutput<true> (3, 2, 0,  false, 5);
+    CheckSameOutput<true> (3, 1, 10, false, 7);
+    CheckSameOutput<true> (4, 2, 10, true,  BENCH_BLOCK_SIZE);
+} // test_same_output_esp8266
+
+//----------------------------------------------------------------------------
+template <bool AdjustAtIsr, bool UseSpecialized>
+static double TimeFrames ()
+{
+    uint32_t Block[BENCH_BLOCK_SIZE];
+    uint32_t Checksum = 0;
+
+    c_PixelEncoder<AdjustAtIsr> Encoder;
+    Encoder.SetConfig (FrameData, BENCH_NUM_PIXELS, 3, 1, 0, false);
+
+    auto Start = std::chrono::steady_clock::now ();
+    for (uint32_t Frame = 0; Frame < BENCH_NUM_FRAMES; ++Frame)
+    {
+        Encoder.StartNewFrame ();
+        while (Encoder.MoreDataToSend ())
+        {
+            size_t NumIntensities = 0;
+            if (UseSpecialized)
+            {
+                NumIntensities = Encoder.EncodeBlock (Block, BENCH_BLOCK_SIZE);
+            }
+            else
+            {
+                while ((NumIntensities < BENCH_BLOCK_SIZE) && Encoder.MoreDataToSend ())
+                {
+                    Block[NumIntensities++] = Encoder.GetNextIntensityToSend ();
+                }
+            }
+            Checksum += Block[0] + Block[NumIntensities - 1];
+        }
+    }
+    auto End = std::chrono::steady_clock::now ();
+
+    // keep the compiler from dropping the encode
+    BenchChecksum = Checksum;
+
+    double ElapsedNs = double (std::chrono::duration_cast<std::chrono::nanoseconds> (End - Start).count ());
+    return ElapsedNs / (double (BENCH_NUM_FRAMES) * double (BENCH_NUM_PIXELS * 3));
+} // TimeFrames
+
+//----------------------------------------------------------------------------
+template <bool AdjustAtIsr>
+static void Benchmark (const char * Name)
+{
+    // warm up the caches
+    TimeFrames<AdjustAtIsr, false> ();
+    TimeFrames<AdjustAtIsr, true> ();
+
+    double GenericNs     = TimeFrames<AdjustAtIsr, false> ();
+    double SpecializedNs = TimeFrames<AdjustAtIsr, true> ();
+
+    char Message[160];
+    snprintf (Message, sizeof (Message), "%s, 680 RGB pixels: state machine %.2f ns/intensity, specialized %.2f ns/intensity (%.2fx)",
+              Name, GenericNs, SpecializedNs, GenericNs / SpecializedNs);
+    TEST_MESSAGE (Message);
+
+} // Benchmark
+
+//----------------------------------------------------------------------------
+static void test_benchmark_esp32 ()
+{
+    Benchmark<false> ("ESP32 (adjusted at latch)");
+} // test_benchmark_esp32
+
+//----------------------------------------------------------------------------
+static void test_benchmark_esp8266 ()
+{
+    Benchmark<true> ("ESP8266 (adjusted in the ISR)");
+} // test_benchmark_esp8266
+
+//----------------------------------------------------------------------------
+int main (int argc, char ** argv)
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_same_output_esp32);
+    RUN_TEST (test_same_output_esp8266);
+    RUN_TEST (test_benchmark_esp32);
+    RUN_TEST (test_benchmark_esp8266);
+    return UNITY_END ();
+} // main
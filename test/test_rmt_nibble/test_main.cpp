@@ -0,0 +1,261 @@
+/*
+* test_main.cpp - Host benchmark of the RMT refill encoders
+*
+* Project: ESPixelStick - An ESP8266 / ESP32 and E1.31 based pixel driver
+* Copyright (c) 2026 ESPixelStick contributors
+*
+*  This program is provided free for you to use in any way that you wish,
+*  subject to the laws and regulations where you are using it.  Due diligence
+*  is strongly suggested before using this code.  Please give credit where due.
+*
+*  The Author makes no warranty of any kind, express or implied, with regard
+*  to this program or the documentation contained in this document.  The
+*  Author shall not be liable in any event for incidental or consequential
+*  damages in connection with, or arising out of, the furnishing, performance
+*  or use of these programs.
+*
+*   Run with: pio test -e native -f test_rmt_nibble
+*
+*   The driver needs the ESP32 RMT registers so the two ways the refill ISR
+*   turns an intensity into RMT items are copied here from
+*   c_OutputRmt::ISR_Handler_SendIntensityData, ISR_EnqueueData,
+*   ISR_EnqueueNibble and UpdateNibble2Rmt. Keep them in step with
+*   OutputRmt.cpp. The times are host times. They show the relative cost of
+*   the two encoders, not the cycles they take on the ESP32.
+*
+*/
+
+#include <unity.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#define NUM_RMT_SLOTS           64      // one RMT memory block
+#define BENCH_NUM_INTENSITIES   (680 * 3)
+#define BENCH_NUM_FRAMES        2000
+
+// ready made items for a zero and a one bit. Only the values matter here
+#define ZERO_BIT_ITEM           0x80100020
+#define ONE_BIT_ITEM            0x80200010
+#define FRAME_START_ITEM        0x00018000
+
+//----------------------------------------------------------------------------
+// The parts of c_OutputRmt the refill ISR uses
+class c_RmtRing
+{
+public:
+    c_RmtRing () { Reset (); }
+
+    void Reset ()
+    {
+        memset ((void *)Mem, 0x00, sizeof (Mem));
+        RmtStartAddr               = &Mem[0];
+        RmtEndAddr                 = &Mem[NUM_RMT_SLOTS - 1];
+        RmtCurrentAddr             = RmtStartAddr;
+        NumAvailableRmtSlotsToFill = NUM_RMT_SLOTS;
+    }
+
+    void SetBitItems (uint32_t ZeroBitValue, uint32_t OneBitValue)
+    {
+        Intensity2Rmt[0] = ZeroBitValue;
+        Intensity2Rmt[1] = OneBitValue;
+
+        for (uint32_t Nibble = 0; Nibble < 16; ++Nibble)
+        {
+            for (uint32_t BitIndex = 0; BitIndex < 4; ++BitIndex)
+            {
+                Nibble2Rmt[Nibble][BitIndex] = (Nibble & (0x08 >> BitIndex)) ? OneBitValue : ZeroBitValue;
+            }
+        }
+    }
+
+    inline void EnqueueData (uint32_t value)
+    {
+        RmtCurrentAddr->val = value;
+
+        --NumAvailableRmtSlotsToFill;
+
+        if (++RmtCurrentAddr > RmtEndAddr)
+        {
+            RmtCurrentAddr = RmtStartAddr;
+        }
+    }
+
+    inline void EnqueueNibble (const uint32_t * pItems)
+    {
+        if (3 <= (RmtEndAddr - RmtCurrentAddr))
+        {
+            RmtCurrentAddr[0].val = pItems[0];
+            RmtCurrentAddr[1].val = pItems[1];
+            RmtCurrentAddr[2].val = pItems[2];
+            RmtCurrentAddr[3].val = pItems[3];
+
+            NumAvailableRmtSlotsToFill -= 4;
+
+            RmtCurrentAddr += 4;
+            if (RmtCurrentAddr > RmtEndAddr)
+            {
+                RmtCurrentAddr = RmtStartAddr;
+            }
+        }
+        else
+        {
+            EnqueueData (pItems[0]);
+            EnqueueData (pItems[1]);
+            EnqueueData (pItems[2]);
+            EnqueueData (pItems[3]);
+        }
+    }
+
+    // the loop the ISR used before the nibble table
+    inline void EncodeBitByBit (uint32_t IntensityValue, uint32_t IntensityDataWidth)
+    {
+        uint32_t OneBitValue  = Intensity2Rmt[1];
+        uint32_t ZeroBitValue = Intensity2Rmt[0];
+
+        for (uint32_t bitmask = 1 << (IntensityDataWidth - 1); 0 != bitmask; bitmask >>= 1)
+        {
+            EnqueueData ((IntensityValue & bitmask) ? OneBitValue : ZeroBitValue);
+        }
+    }
+
+    inline void EncodeByNibble (uint32_t IntensityValue, uint32_t IntensityDataWidth)
+    {
+        for (int32_t Shift = int32_t (IntensityDataWidth) - 4; 0 <= Shift; Shift -= 4)
+        {
+            uint32_t Nibble = (IntensityValue >> Shift) & 0x0F;
+            EnqueueNibble (Nibble2Rmt[Nibble]);
+        }
+    }
+
+    struct rmt_item32_t { uint32_t val; };
+
+    volatile rmt_item32_t   Mem[NUM_RMT_SLOTS];
+    volatile rmt_item32_t * RmtStartAddr    = nullptr;
+    volatile rmt_item32_t * RmtEndAddr      = nullptr;
+    volatile rmt_item32_t * RmtCurrentAddr  = nullptr;
+    volatile size_t         NumAvailableRmtSlotsToFill = 0;
+    uint32_t                Intensity2Rmt[2];
+    uint32_t                Nibble2Rmt[16][4];
+
+}; // c_RmtRing
+
+static uint8_t FrameData[BENCH_NUM_INTENSITIES];
+
+//----------------------------------------------------------------------------
+void setUp ()
+{
+    // the same pseudo random frame every run
+    uint32_t Seed = 0x12345678;
+    for (auto & Intensity : FrameData)
+    {
+        Seed = (Seed * 1103515245) + 12345;
+        Intensity = uint8_t (Seed >> 16);
+    }
+} // setUp
+
+//----------------------------------------------------------------------------
+void tearDown ()
+{
+} // tearDown
+
+//----------------------------------------------------------------------------
+/*
+    Both encoders have to leave the same items in the same slots, including
+    when a nibble straddles the end of the ring.
+*/
+static void CheckSameOutput (uint32_t IntensityDataWidth)
+{
+    c_RmtRing BitByBit;
+    c_RmtRing ByNibble;
+    BitByBit.SetBitItems (ZERO_BIT_ITEM, ONE_BIT_ITEM);
+    ByNibble.SetBitItems (ZERO_BIT_ITEM, ONE_BIT_ITEM);
+
+    // a frame start item moves the nibbles off the four slot boundary
+    BitByBit.EnqueueData (FRAME_START_ITEM);
+    ByNibble.EnqueueData (FRAME_START_ITEM);
+
+    uint32_t Mask = (1 << IntensityDataWidth) - 1;
+    for (size_t index = 0; index < 200; ++index)
+    {
+        uint32_t IntensityValue = ((uint32_t (FrameData[index]) << 8) | FrameData[index + 1]) & Mask;
+        BitByBit.EncodeBitByBit (IntensityValue, IntensityDataWidth);
+        ByNibble.EncodeByNibble (IntensityValue, IntensityDataWidth);
+
+        TEST_ASSERT_EQUAL_INT (BitByBit.RmtCurrentAddr - BitByBit.RmtStartAddr, ByNibble.RmtCurrentAddr - ByNibble.RmtStartAddr);
+        TEST_ASSERT_EQUAL (BitByBit.NumAvailableRmtSlotsToFill, ByNibble.NumAvailableRmtSlotsToFill);
+        for (size_t slot = 0; slot < NUM_RMT_SLOTS; ++slot)
+        {
+            TEST_ASSERT_EQUAL_HEX32 (BitByBit.Mem[slot].val, ByNibble.Mem[slot].val);
+        }
+    }
+} // CheckSameOutput
+
+//----------------------------------------------------------------------------
+static void test_same_output_8_bit ()
+{
+    CheckSameOutput (8);
+} // test_same_output_8_bit
+
+//----------------------------------------------------------------------------
+static void test_same_output_16_bit ()
+{
+    CheckSameOutput (16);
+} // test_same_output_16_bit
+
+//----------------------------------------------------------------------------
+template <bool UseNibbles>
+static double TimeFrames ()
+{
+    c_RmtRing Ring;
+    Ring.SetBitItems (ZERO_BIT_ITEM, ONE_BIT_ITEM);
+
+    auto Start = std::chrono::steady_clock::now ();
+    for (uint32_t Frame = 0; Frame < BENCH_NUM_FRAMES; ++Frame)
+    {
+        Ring.EnqueueData (FRAME_START_ITEM);
+        for (auto Intensity : FrameData)
+        {
+            if (UseNibbles)
+            {
+                Ring.EncodeByNibble (Intensity, 8);
+            }
+            else
+            {
+                Ring.EncodeBitByBit (Intensity, 8);
+            }
+        }
+    }
+    auto End = std::chrono::steady_clock::now ();
+
+    double ElapsedNs = double (std::chrono::duration_cast<std::chrono::nanoseconds> (End - Start).count ());
+    return ElapsedNs / (double (BENCH_NUM_FRAMES) * double (BENCH_NUM_INTENSITIES));
+} // TimeFrames
+
+//----------------------------------------------------------------------------
+static void test_benchmark ()
+{
+    // warm up the caches
+    TimeFrames<false> ();
+    TimeFrames<true> ();
+
+    double BitByBitNs = TimeFrames<false> ();
+    double ByNibbleNs = TimeFrames<true> ();
+
+    char Message[128];
+    snprintf (Message, sizeof (Message), "680 RGB pixels, 8 bit: bit by bit %.2f ns/intensity, nibble table %.2f ns/intensity (%.2fx)",
+              BitByBitNs, ByNibbleNs, BitByBitNs / ByNibbleNs);
+    TEST_MESSAGE (Message);
+
+} // test_benchmark
+
+//----------------------------------------------------------------------------
+int main (int argc, char ** argv)
+{
+    UNITY_BEGIN ();
+    RUN_TEST (test_same_output_8_bit);
+    RUN_TEST (test_same_output_16_bit);
+    RUN_TEST (test_benchmark);
+    return UNITY_END ();
+} // main